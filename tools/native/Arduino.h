@@ -0,0 +1,141 @@
+#ifndef WLED_NATIVE_ARDUINO_H
+#define WLED_NATIVE_ARDUINO_H
+
+/*
+ * Minimal Arduino core replacement for the host (env:native) build.
+ * Only what the effect engine (FX*.cpp, colors.cpp, bus_manager.cpp) needs is provided.
+ * Time is virtual: millis()/micros() only advance via delay() or hostAdvanceMillis() so
+ * effects render deterministically regardless of host speed.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <sys/param.h> // MIN(), MAX()
+#include <cmath>
+#include <cstdlib>
+
+typedef uint8_t  byte;
+typedef bool     boolean;
+
+using std::abs;
+using std::isinf;
+using std::isnan;
+
+#ifndef PI
+#define PI          3.1415926535897932384626433832795
+#endif
+#define HALF_PI     1.5707963267948966192313216916398
+#define TWO_PI      6.283185307179586476925286766559
+#define DEG_TO_RAD  0.017453292519943295769236907684886
+#define RAD_TO_DEG  57.295779513082320876798154814105
+
+#define LOW  0x0
+#define HIGH 0x1
+
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+
+// flash access is plain memory access on the host
+#define PROGMEM
+#define PGM_P                     const char *
+#define PSTR(s)                   (s)
+#define F(s)                      (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+#define FPSTR(p)                  (reinterpret_cast<const __FlashStringHelper *>(p))
+#define pgm_read_byte(addr)       (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr)  pgm_read_byte(addr)
+#define pgm_read_word(addr)       (*(const uint16_t *)(addr))
+// pgm_read_dword() is also used to fetch pointers from PROGMEM tables, which are 64 bit wide on the host
+#define pgm_read_dword(addr)      (*(addr))
+#define pgm_read_float(addr)      (*(const float *)(addr))
+#define pgm_read_ptr(addr)        (*(const void * const *)(addr))
+#define memcpy_P                  memcpy
+#define memcmp_P                  memcmp
+#define strlen_P                  strlen
+#define strcpy_P                  strcpy
+#define strncpy_P                 strncpy
+#define strcmp_P                  strcmp
+#define strncmp_P                 strncmp
+#define strcat_P                  strcat
+#define strstr_P                  strstr
+#define sprintf_P                 sprintf
+#define snprintf_P                snprintf
+#define vsnprintf_P               vsnprintf
+class __FlashStringHelper;
+
+#define bitRead(value, bit)            (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)             ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)           ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define lowByte(w)                     ((uint8_t) ((w) & 0xff))
+#define highByte(w)                    ((uint8_t) ((w) >> 8))
+#define constrain(amt,low,high)        ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define sq(x)                          ((x)*(x))
+#define radians(deg)                   ((deg)*DEG_TO_RAD)
+#define degrees(rad)                   ((rad)*RAD_TO_DEG)
+
+template<class T, class L> auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template<class T, class L> auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+
+inline uint16_t word(uint8_t h, uint8_t l) { return (h << 8) | l; }
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  if (in_max == in_min) return out_min;
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// virtual clock (see arduino_native.cpp)
+uint32_t millis(); // 32 bit like on ESP, so rollover math behaves the same
+uint32_t micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline void yield() {}
+void hostAdvanceMillis(unsigned long ms);
+void hostSetMillis(unsigned long ms);
+
+// GPIO has no hardware behind it on the host
+#define INPUT         0x01
+#define OUTPUT        0x03
+#define INPUT_PULLUP  0x05
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t) { return LOW; }
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) { size_t n = len < size-1 ? len : size-1; memcpy(dst, src, n); dst[n] = '\0'; }
+  return len;
+}
+#endif
+
+// Serial prints to stdout
+class HardwareSerial {
+  public:
+    void begin(unsigned long) {}
+    template<typename T> size_t print(const T& v)   { return printValue(v); }
+    template<typename T> size_t println(const T& v) { size_t n = printValue(v); putchar('\n'); return n + 1; }
+    size_t println()                                { putchar('\n'); return 1; }
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+    size_t printf_P(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+    void flush() { fflush(stdout); }
+  private:
+    size_t printValue(const char *s)                  { return fputs(s, stdout); }
+    size_t printValue(const __FlashStringHelper *s)   { return fputs(reinterpret_cast<const char *>(s), stdout); }
+    size_t printValue(char c)                         { putchar(c); return 1; }
+    size_t printValue(long v)                         { return ::printf("%ld", v); }
+    size_t printValue(unsigned long v)                { return ::printf("%lu", v); }
+    size_t printValue(int v)                          { return ::printf("%d", v); }
+    size_t printValue(unsigned v)                     { return ::printf("%u", v); }
+    size_t printValue(double v)                       { return ::printf("%.2f", v); }
+};
+extern HardwareSerial Serial;
+
+#endif
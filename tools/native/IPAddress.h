@@ -0,0 +1,22 @@
+#ifndef WLED_NATIVE_IPADDRESS_H
+#define WLED_NATIVE_IPADDRESS_H
+
+// Host (env:native) stand-in for the Arduino IPAddress class (storage and comparison only).
+
+#include <Arduino.h>
+
+class IPAddress {
+  public:
+    IPAddress() : _addr{0,0,0,0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _addr{a,b,c,d} {}
+    IPAddress(uint32_t a) { memcpy(_addr, &a, 4); }
+    operator uint32_t() const { uint32_t a; memcpy(&a, _addr, 4); return a; }
+    bool operator==(const IPAddress& o) const { return memcmp(_addr, o._addr, 4) == 0; }
+    bool operator!=(const IPAddress& o) const { return !(*this == o); }
+    uint8_t  operator[](int i) const { return _addr[i]; }
+    uint8_t& operator[](int i)       { return _addr[i]; }
+  private:
+    uint8_t _addr[4];
+};
+
+#endif
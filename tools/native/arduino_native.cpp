@@ -0,0 +1,59 @@
+/*
+ * Arduino core functions for the host (env:native) build.
+ */
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+HardwareSerial Serial;
+
+// virtual clock in microseconds; starts at 1s so "time since boot" math never underflows
+static uint64_t hostMicros = 1000000ULL;
+
+uint32_t millis() { return hostMicros / 1000ULL; }
+uint32_t micros() { return hostMicros; }
+void delay(unsigned long ms) { hostMicros += ms * 1000ULL; }
+void delayMicroseconds(unsigned int us) { hostMicros += us; }
+void hostAdvanceMillis(unsigned long ms) { hostMicros += ms * 1000ULL; }
+void hostSetMillis(unsigned long ms) { hostMicros = ms * 1000ULL; }
+
+// deterministic PRNG so benchmark runs are reproducible
+static uint32_t hostRandomState = 1;
+
+static uint32_t hostRandom() {
+  // xorshift32
+  hostRandomState ^= hostRandomState << 13;
+  hostRandomState ^= hostRandomState >> 17;
+  hostRandomState ^= hostRandomState << 5;
+  return hostRandomState;
+}
+
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  return hostRandom() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed) hostRandomState = seed;
+}
+
+size_t HardwareSerial::printf(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  int n = vprintf(fmt, args);
+  va_end(args);
+  return n < 0 ? 0 : n;
+}
+
+size_t HardwareSerial::printf_P(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  int n = vprintf(fmt, args);
+  va_end(args);
+  return n < 0 ? 0 : n;
+}
@@ -0,0 +1,344 @@
+/*
+ * Headless effect benchmark for the host (env:native) build.
+ *
+ * Runs every registered effect (WS2812FX::_mode/_modeData) through the regular
+ * WS2812FX::service() path across a matrix of segment configurations and records
+ * per effect and configuration:
+ *  - wall-clock time per frame (us)
+ *  - segment data high-water mark (bytes claimed through Segment::allocateData())
+ *  - pixels written to the busses per frame
+ *  - hash of the bus output of all frames, to check that optimizations do not change the output
+ * The virtual clock advances by one frame time per iteration, so effect output is
+ * identical between runs regardless of host speed.
+ *
+ * Frames are timed in batches and the fastest batch counts, to reduce noise.
+ * Results are printed as a table and can be written as JSON (-j) and/or CSV (-c).
+ * A previous JSON report can be given as baseline (-b) to list regressions and
+ * effects whose output changed, and
+ * an FPS target (-t) lists effects that are too slow; either makes the exit code 2.
+ *
+ * usage: program [options], see usage() below
+ */
+
+#include "wled_native.h"
+#include "polybus_native.h" // PolyBus::pixelWrites
+#include <chrono>
+#include <vector>
+#include <string>
+
+// one segment configuration of the benchmark matrix
+typedef struct BenchConfig {
+  const char *name;
+  uint16_t width;    // LEDs (1D) or matrix width (2D)
+  uint16_t height;   // 1 for 1D
+  uint8_t  grouping;
+  uint8_t  spacing;
+  bool     reverse;
+  bool     mirror;
+  uint8_t  map1D2D;  // mapping of 1D effects on 2D, see M12_* in FX.h
+} bench_config_t;
+
+static const bench_config_t benchSuite[] = {
+  // name            w     h   grp spc rev    mirror map1D2D
+  {"1d-30",          30,   1,  1,  0,  false, false, M12_Pixels},
+  {"1d-300",         300,  1,  1,  0,  false, false, M12_Pixels},
+  {"1d-1500",        1500, 1,  1,  0,  false, false, M12_Pixels},
+  {"1d-300-g2s1",    300,  1,  2,  1,  false, false, M12_Pixels},
+  {"1d-300-g4s0",    300,  1,  4,  0,  false, false, M12_Pixels},
+  {"1d-300-rev",     300,  1,  1,  0,  true,  false, M12_Pixels},
+  {"1d-300-mirror",  300,  1,  1,  0,  false, true,  M12_Pixels},
+  {"1d-300-rev-mir", 300,  1,  1,  0,  true,  true,  M12_Pixels},
+  {"2d-16x16",       16,   16, 1,  0,  false, false, M12_Pixels},
+  {"2d-32x32",       32,   32, 1,  0,  false, false, M12_Pixels},
+  {"2d-64x64",       64,   64, 1,  0,  false, false, M12_Pixels},
+  {"2d-32x32-g2s0",  32,   32, 2,  0,  false, false, M12_Pixels},
+  {"2d-32x32-mir",   32,   32, 1,  0,  true,  true,  M12_Pixels},
+  {"2d-32x32-bar",   32,   32, 1,  0,  false, false, M12_pBar},
+  {"2d-32x32-arc",   32,   32, 1,  0,  false, false, M12_pArc},
+  {"2d-32x32-corner",32,   32, 1,  0,  false, false, M12_pCorner},
+};
+
+typedef struct BenchResult {
+  const char *config;
+  uint8_t  id;
+  char     name[33];
+  bool     is2D;
+  uint16_t leds;
+  double   usPerFrame;
+  uint32_t dataBytes;      // high-water of Segment::getUsedSegmentData()
+  uint32_t writesPerFrame;
+  uint32_t outputHash;
+} bench_result_t;
+
+static void usage(const char *name) {
+  printf("usage: %s [options]\n", name);
+  printf("  -l leds      benchmark a single 1D strip of this length instead of the suite\n");
+  printf("  -m WxH       benchmark a single W x H matrix instead of the suite\n");
+  printf("  -s filter    only run suite configurations whose name contains filter\n");
+  printf("  -f frames    frames rendered per effect (default 200)\n");
+  printf("  -e effect    only benchmark this effect ID\n");
+  printf("  -j file      write JSON report\n");
+  printf("  -c file      write CSV report\n");
+  printf("  -b file      compare against a previous JSON report\n");
+  printf("  -r percent   slowdown vs. baseline reported as regression (default 10)\n");
+  printf("  -t fps       report effects rendering slower than this frame rate\n");
+}
+
+// copies the effect name (up to '@' or ';') from its metadata string
+static void getModeName(uint8_t mode, char *dest, size_t len) {
+  const char *data = strip.getModeData(mode);
+  size_t i = 0;
+  for (; i < len-1 && data[i] && data[i] != '@' && data[i] != ';'; i++) dest[i] = data[i];
+  dest[i] = '\0';
+}
+
+// effect flags are the 4th ';' separated field of the metadata ("1" if omitted)
+static bool isMode2D(uint8_t mode) {
+  const char *data = strip.getModeData(mode);
+  for (int f = 0; f < 3; f++) {
+    data = strchr(data, ';');
+    if (!data) return false;
+    data++;
+  }
+  for (; *data && *data != ';'; data++) if (*data == '2') return true;
+  return false;
+}
+
+// (re)creates busses, matrix and main segment for the given configuration
+static bool setupStrip(const bench_config_t &cfg) {
+  busses.removeAll();
+  #ifndef WLED_DISABLE_2D
+  strip.panel.clear();
+  strip.isMatrix = cfg.height > 1;
+  if (strip.isMatrix) {
+    if (cfg.width > 255 || cfg.height > 255) return false; // panel dimensions are 8 bit
+    WS2812FX::Panel p;
+    p.width  = cfg.width;
+    p.height = cfg.height;
+    strip.panels = 1;
+    strip.panel.push_back(p);
+  }
+  #else
+  if (cfg.height > 1) return false;
+  #endif
+  unsigned leds = cfg.width * cfg.height;
+  if (!leds || leds > MAX_LEDS) return false;
+
+  uint8_t pins[] = {2};
+  BusConfig bc = BusConfig(TYPE_WS2812_RGB, pins, 0, leds, COL_ORDER_GRB);
+  if (busses.add(bc) == -1) return false;
+
+  // same sequence as WLED::beginStrip()
+  strip.finalizeInit();
+  strip.makeAutoSegments(true);
+  strip.setBrightness(255, true);
+
+  Segment &seg = strip.getMainSegment();
+  #ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) strip.setSegment(0, 0, cfg.width, cfg.grouping, cfg.spacing, UINT16_MAX, 0, cfg.height);
+  else
+  #endif
+  strip.setSegment(0, 0, cfg.width, cfg.grouping, cfg.spacing);
+  seg.setOption(SEG_OPTION_REVERSED, cfg.reverse);
+  seg.setOption(SEG_OPTION_MIRROR, cfg.mirror);
+  #ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) {
+    seg.reverse_y = cfg.reverse;
+    seg.mirror_y  = cfg.mirror;
+  }
+  #endif
+  seg.map1D2D = cfg.map1D2D;
+  return true;
+}
+
+static bench_result_t runEffect(const bench_config_t &cfg, uint8_t mode, unsigned frames) {
+  bench_result_t r;
+  r.config = cfg.name;
+  r.id     = mode;
+  getModeName(mode, r.name, sizeof(r.name));
+  r.is2D   = isMode2D(mode);
+  r.leds   = cfg.width * cfg.height;
+
+  Segment &seg = strip.getMainSegment();
+  seg.setMode(mode);
+  strip.trigger();
+  strip.service(); // first frame allocates effect data, keep it out of the measurement
+  uint32_t dataBytes = Segment::getUsedSegmentData();
+
+  // frames are timed in batches and the fastest batch is reported, which filters out host scheduling noise
+  const unsigned batches = frames >= 50 ? 5 : 1;
+  double bestUs = 0;
+  PolyBus::pixelWrites = 0;
+  PolyBus::outputHash  = 0;
+  for (unsigned b = 0; b < batches; b++) {
+    unsigned n = frames / batches;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned f = 0; f < n; f++) {
+      hostAdvanceMillis(strip.getFrameTime());
+      strip.trigger(); // render every iteration, even for effects that request a longer delay
+      strip.service();
+      if (Segment::getUsedSegmentData() > dataBytes) dataBytes = Segment::getUsedSegmentData();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count() / (n ? n : 1);
+    if (!b || us < bestUs) bestUs = us;
+  }
+
+  r.usPerFrame     = bestUs;
+  r.dataBytes      = dataBytes;
+  r.writesPerFrame = PolyBus::pixelWrites / (frames ? frames : 1);
+  r.outputHash     = PolyBus::outputHash;
+  return r;
+}
+
+static bool writeJSON(const char *file, const std::vector<bench_result_t> &results, unsigned frames) {
+  FILE *f = fopen(file, "w");
+  if (!f) return false;
+  fprintf(f, "{\"ver\":\"%s\",\"frames\":%u,\"results\":[\n", WLED_VERSION, frames);
+  for (size_t i = 0; i < results.size(); i++) {
+    const bench_result_t &r = results[i];
+    fprintf(f, "{\"cfg\":\"%s\",\"id\":%u,\"name\":\"%s\",\"2d\":%s,\"leds\":%u,\"us\":%.2f,\"fps\":%.1f,\"data\":%u,\"writes\":%u,\"hash\":\"%08x\"}%s\n",
+      r.config, r.id, r.name, r.is2D ? "true" : "false", r.leds, r.usPerFrame, r.usPerFrame > 0 ? 1e6/r.usPerFrame : 0,
+      r.dataBytes, r.writesPerFrame, r.outputHash, i+1 < results.size() ? "," : "");
+  }
+  fprintf(f, "]}\n");
+  fclose(f);
+  return true;
+}
+
+static bool writeCSV(const char *file, const std::vector<bench_result_t> &results) {
+  FILE *f = fopen(file, "w");
+  if (!f) return false;
+  fprintf(f, "config,id,effect,2d,leds,us_per_frame,fps,data_bytes,writes_per_frame,hash\n");
+  for (const bench_result_t &r : results) {
+    fprintf(f, "%s,%u,\"%s\",%u,%u,%.2f,%.1f,%u,%u,%08x\n",
+      r.config, r.id, r.name, r.is2D, r.leds, r.usPerFrame, r.usPerFrame > 0 ? 1e6/r.usPerFrame : 0, r.dataBytes, r.writesPerFrame, r.outputHash);
+  }
+  fclose(f);
+  return true;
+}
+
+// lists results that got slower than the baseline report by more than tolerance percent,
+// and those whose output differs (only if both runs rendered the same number of frames)
+// (reports written by writeJSON() hold one result per line, which is parsed on its own)
+static int compareBaseline(const char *file, const std::vector<bench_result_t> &results, unsigned frames, float tolerance) {
+  FILE *f = fopen(file, "r");
+  if (!f) { printf("cannot open baseline %s\n", file); return -1; }
+
+  int regressions = 0, changed = 0;
+  unsigned baseFrames = 0;
+  char line[512];
+  StaticJsonDocument<512> b;
+  std::vector<std::string> changes;
+  printf("\nregressions vs. %s (>%.0f%% slower):\n", file, tolerance);
+  while (fgets(line, sizeof(line), f)) {
+    const char *fr = strstr(line, "\"frames\":");
+    if (!baseFrames && fr) baseFrames = atoi(fr + 9);
+    if (strncmp_P(line, PSTR("{\"cfg\""), 6)) continue;
+    if (deserializeJson(b, line)) continue;
+    const char *cfg  = b[F("cfg")];
+    uint8_t id       = b[F("id")];
+    float   baseUs   = b[F("us")];
+    const char *hash = b[F("hash")];
+    if (!cfg || baseUs <= 0) continue;
+    for (const bench_result_t &r : results) {
+      if (r.id != id || strcmp(r.config, cfg)) continue;
+      float delta = (r.usPerFrame - baseUs) * 100.0f / baseUs;
+      if (delta > tolerance) {
+        printf("  %-16s %3u %-24s %10.1f -> %10.1f us (%+.0f%%)\n", cfg, id, r.name, baseUs, r.usPerFrame, delta);
+        regressions++;
+      }
+      if (hash && baseFrames == frames && strtoul(hash, nullptr, 16) != r.outputHash) {
+        char buf[80];
+        snprintf(buf, sizeof(buf), "  %-16s %3u %s", cfg, id, r.name);
+        changes.push_back(buf);
+        changed++;
+      }
+      break;
+    }
+  }
+  fclose(f);
+  if (!regressions) printf("  none\n");
+  if (baseFrames == frames) {
+    printf("\noutput differs from %s:\n", file);
+    for (const std::string &c : changes) printf("%s\n", c.c_str());
+    if (!changed) printf("  none\n");
+  }
+  return regressions;
+}
+
+int main(int argc, char *argv[]) {
+  unsigned frames = 200;
+  int onlyMode = -1;
+  const char *filter = nullptr, *jsonFile = nullptr, *csvFile = nullptr, *baseFile = nullptr;
+  float tolerance = 10.0f, targetFps = 0.0f;
+  bench_config_t single = {"custom", 0, 1, 1, 0, false, false, M12_Pixels};
+
+  for (int i = 1; i < argc; i++) {
+    bool hasArg = i+1 < argc;
+    if      (!strcmp(argv[i], "-l") && hasArg) single.width = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-m") && hasArg) { unsigned w, h; if (sscanf(argv[++i], "%ux%u", &w, &h) == 2) { single.width = w; single.height = h; } }
+    else if (!strcmp(argv[i], "-s") && hasArg) filter    = argv[++i];
+    else if (!strcmp(argv[i], "-f") && hasArg) frames    = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-e") && hasArg) onlyMode  = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-j") && hasArg) jsonFile  = argv[++i];
+    else if (!strcmp(argv[i], "-c") && hasArg) csvFile   = argv[++i];
+    else if (!strcmp(argv[i], "-b") && hasArg) baseFile  = argv[++i];
+    else if (!strcmp(argv[i], "-r") && hasArg) tolerance = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-t") && hasArg) targetFps = atof(argv[++i]);
+    else { usage(argv[0]); return 1; }
+  }
+
+  std::vector<bench_config_t> configs;
+  if (single.width) configs.push_back(single);
+  else for (const bench_config_t &cfg : benchSuite) {
+    if (!filter || strstr(cfg.name, filter)) configs.push_back(cfg);
+  }
+
+  modeBlending   = false; // measure each effect on its own
+  fadeTransition = false;
+
+  std::vector<bench_result_t> results;
+  printf("%u frames per effect\n", frames);
+  printf("%-16s %3s  %-24s %10s %8s %8s %8s\n", "config", "id", "effect", "us/frame", "fps", "data", "writes");
+  for (const bench_config_t &cfg : configs) {
+    if (!setupStrip(cfg)) { printf("%-16s skipped: cannot set up %ux%u LEDs\n", cfg.name, cfg.width, cfg.height); continue; }
+    bool matrix = cfg.height > 1;
+
+    for (unsigned mode = 0; mode < strip.getModeCount(); mode++) {
+      if (onlyMode >= 0 && mode != (unsigned)onlyMode) continue;
+      char name[33];
+      getModeName(mode, name, sizeof(name));
+      if (!strcmp_P(name, PSTR("RSVD"))) continue; // reserved slot, no effect behind it
+      bool is2D = isMode2D(mode);
+      if (is2D && !matrix) continue;                                  // 2D effects need a matrix
+      if (matrix && is2D && cfg.map1D2D != M12_Pixels) continue;      // mapping only affects 1D effects
+
+      bench_result_t r = runEffect(cfg, mode, frames);
+      results.push_back(r);
+      printf("%-16s %3u  %-24s %10.1f %8.0f %8u %8u\n", r.config, r.id, r.name, r.usPerFrame,
+        r.usPerFrame > 0 ? 1e6/r.usPerFrame : 0, r.dataBytes, r.writesPerFrame);
+    }
+  }
+
+  if (jsonFile && !writeJSON(jsonFile, results, frames)) printf("cannot write %s\n", jsonFile);
+  if (csvFile  && !writeCSV(csvFile, results))           printf("cannot write %s\n", csvFile);
+
+  int failed = 0;
+  if (baseFile) {
+    int regressions = compareBaseline(baseFile, results, frames, tolerance);
+    if (regressions) failed = 1;
+  }
+  if (targetFps > 0) {
+    int slow = 0;
+    printf("\nbelow %.0f FPS:\n", targetFps);
+    for (const bench_result_t &r : results) {
+      if (r.usPerFrame <= 0 || 1e6/r.usPerFrame >= targetFps) continue;
+      printf("  %-16s %3u %-24s %8.1f fps\n", r.config, r.id, r.name, 1e6/r.usPerFrame);
+      slow++;
+    }
+    if (!slow) printf("  none\n");
+    else failed = 1;
+  }
+  return failed ? 2 : 0;
+}
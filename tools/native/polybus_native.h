@@ -0,0 +1,125 @@
+#ifndef WLED_NATIVE_POLYBUS_H
+#define WLED_NATIVE_POLYBUS_H
+
+/*
+ * Host replacement for bus_wrapper.h (env:native).
+ * Every digital bus is an in-memory pixel array: channels are reordered and dimmed
+ * on write the same way NeoPixelBusLg does, so BusDigital sees identical lossy
+ * read-back behaviour. show() only counts frames.
+ * PolyBus::pixelWrites counts every pixel written to any bus and PolyBus::outputHash
+ * accumulates a hash of every shown frame (used by the benchmark to detect output changes).
+ */
+
+#include "const.h"
+
+#define I_NONE   0
+#define I_HS_MEM 1 // in-memory bus standing in for all digital types
+
+struct NativeBus {
+  uint32_t *pixels;
+  uint16_t  len;
+  uint8_t   bri;
+  uint32_t  frames; // number of show() calls
+};
+
+class PolyBus {
+  public:
+  static inline uint32_t pixelWrites = 0;
+  static inline uint32_t outputHash  = 0;
+
+  static void begin(void* busPtr, uint8_t busType, uint8_t* pins, uint16_t clock_kHz = 0U) {}
+
+  static void* create(uint8_t busType, uint8_t* pins, uint16_t len, uint8_t channel, uint16_t clock_kHz = 0U) {
+    if (busType == I_NONE || !len) return nullptr;
+    NativeBus *bus = new NativeBus;
+    bus->pixels = (uint32_t *)calloc(len, sizeof(uint32_t));
+    bus->len    = len;
+    bus->bri    = 255;
+    bus->frames = 0;
+    return bus;
+  }
+
+  static void show(void* busPtr, uint8_t busType, bool consistent = true) {
+    NativeBus *bus = static_cast<NativeBus*>(busPtr);
+    if (!bus) return;
+    bus->frames++;
+    uint32_t h = outputHash ^ 2166136261U; // FNV-1a
+    for (uint16_t i = 0; i < bus->len; i++) h = (h ^ bus->pixels[i]) * 16777619U;
+    outputHash = h;
+  }
+
+  static bool canShow(void* busPtr, uint8_t busType) { return true; }
+
+  static void setPixelColor(void* busPtr, uint8_t busType, uint16_t pix, uint32_t c, uint8_t co) {
+    NativeBus *bus = static_cast<NativeBus*>(busPtr);
+    if (!bus || pix >= bus->len) return;
+    pixelWrites++;
+    uint8_t r = c >> 16;
+    uint8_t g = c >> 8;
+    uint8_t b = c >> 0;
+    uint8_t w = c >> 24;
+    uint8_t cG, cR, cB, cW;
+
+    // reorder channels to selected order
+    switch (co & 0x0F) {
+      default: cG = g; cR = r; cB = b; break; //0 = GRB, default
+      case  1: cG = r; cR = g; cB = b; break; //1 = RGB, common for WS2811
+      case  2: cG = b; cR = r; cB = g; break; //2 = BRG
+      case  3: cG = r; cR = b; cB = g; break; //3 = RBG
+      case  4: cG = b; cR = g; cB = r; break; //4 = BGR
+      case  5: cG = g; cR = b; cB = r; break; //5 = GBR
+    }
+    // upper nibble contains W swap information
+    switch (co >> 4) {
+      default: cW = w;           break; // no swapping
+      case  1: cW = cB; cB = w;  break; // swap W & B
+      case  2: cW = cG; cG = w;  break; // swap W & G
+      case  3: cW = cR; cR = w;  break; // swap W & R
+    }
+    // luminance is applied on write, as NeoPixelBusLg does
+    uint16_t s = bus->bri + 1;
+    bus->pixels[pix] = ((cW*s >> 8) << 24) | ((cR*s >> 8) << 16) | ((cG*s >> 8) << 8) | (cB*s >> 8);
+  }
+
+  static void setBrightness(void* busPtr, uint8_t busType, uint8_t b) {
+    if (busPtr) static_cast<NativeBus*>(busPtr)->bri = b;
+  }
+
+  static uint32_t getPixelColor(void* busPtr, uint8_t busType, uint16_t pix, uint8_t co) {
+    NativeBus *bus = static_cast<NativeBus*>(busPtr);
+    if (!bus || pix >= bus->len) return 0;
+    uint32_t c = bus->pixels[pix];
+    uint8_t cW = c >> 24, cR = c >> 16, cG = c >> 8, cB = c;
+
+    // upper nibble contains W swap information
+    uint8_t w = cW;
+    switch (co >> 4) {
+      case 1: w = cB; cB = cW; break; // swap W & B
+      case 2: w = cG; cG = cW; break; // swap W & G
+      case 3: w = cR; cR = cW; break; // swap W & R
+    }
+    switch (co & 0x0F) {
+      //                    W            G              R               B
+      default: return ((w << 24) | (cG << 8) | (cR << 16) | (cB)); //0 = GRB, default
+      case  1: return ((w << 24) | (cR << 8) | (cG << 16) | (cB)); //1 = RGB, common for WS2811
+      case  2: return ((w << 24) | (cB << 8) | (cR << 16) | (cG)); //2 = BRG
+      case  3: return ((w << 24) | (cB << 8) | (cG << 16) | (cR)); //3 = RBG
+      case  4: return ((w << 24) | (cR << 8) | (cB << 16) | (cG)); //4 = BGR
+      case  5: return ((w << 24) | (cG << 8) | (cB << 16) | (cR)); //5 = GBR
+    }
+  }
+
+  static void cleanup(void* busPtr, uint8_t busType) {
+    NativeBus *bus = static_cast<NativeBus*>(busPtr);
+    if (!bus) return;
+    free(bus->pixels);
+    delete bus;
+  }
+
+  static uint8_t getI(uint8_t busType, uint8_t* pins, uint8_t num = 0) {
+    if (!IS_DIGITAL(busType)) return I_NONE;
+    return I_HS_MEM;
+  }
+};
+
+#endif
@@ -0,0 +1,226 @@
+/*
+ * Definitions backing wled_native.h for the host (env:native) build.
+ * Globals carry the same defaults as wled.h; helpers that live in util.cpp,
+ * file.cpp, led.cpp and udp.cpp are reduced to what the effect engine needs.
+ */
+
+#include "wled_native.h"
+
+// globals (see wled.h)
+bool autoSegments            = false;
+bool useGlobalLedBuffer      = true;  // as on ESP32
+bool correctWB               = false;
+bool cctFromRgb              = false;
+bool gammaCorrectCol         = true;
+bool gammaCorrectBri         = false;
+float gammaCorrectVal        = 2.8f;
+bool fadeTransition          = true;
+bool modeBlending            = true;
+uint8_t randomPaletteChangeTime = 5;
+bool stateChanged            = false;
+bool useAMPM                 = false;
+byte realtimeMode            = REALTIME_MODE_INACTIVE;
+time_t localTime             = 0;
+byte errorFlag               = 0;
+byte lastRandomIndex         = 0;
+char *ledmapNames[WLED_MAX_LEDMAPS-1] = {nullptr};
+StaticJsonDocument<JSON_BUFFER_SIZE> doc;
+Toki toki = Toki();
+BusConfig* busConfigs[WLED_MAX_BUSSES+WLED_MIN_VIRTUAL_BUSSES] = {nullptr};
+BusManager busses = BusManager();
+WS2812FX strip = WS2812FX();
+
+NativeFS WLED_FS;
+UsermodManager usermods;
+
+//led.cpp
+uint32_t get_millisecond_timer()
+{
+  return strip.now;
+}
+
+//file.cpp
+bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest)
+{
+  return false;
+}
+
+//udp.cpp
+byte *realtimeBroadcastPacket(uint8_t type, bool isRGBW)
+{
+  return (byte *)calloc(1, 1); // network busses stay valid, nothing is ever sent
+}
+
+uint8_t realtimeBroadcast(uint8_t type, const IPAddress *clients, uint8_t numClients, uint16_t universe, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW, byte *packet)
+{
+  return 1; // network output is not available on the host
+}
+
+void realtimeBroadcastSync(const IPAddress *, uint8_t) {}
+
+//e131.cpp
+int realtimeInputIndex(uint8_t universe, uint8_t pixel) { return universe * 256 + pixel; } // no realtime input on the host
+
+//util.cpp
+static volatile uint8_t jsonBufferLock = 0;
+
+bool requestJSONBufferLock(uint8_t module)
+{
+  if (jsonBufferLock) return false;
+  jsonBufferLock = module ? module : 255;
+  doc.clear();
+  return true;
+}
+
+void releaseJSONBufferLock()
+{
+  jsonBufferLock = 0;
+}
+
+int16_t extractModeDefaults(uint8_t mode, const char *segVar)
+{
+  if (mode < strip.getModeCount()) {
+    char lineBuffer[256];
+    strncpy_P(lineBuffer, strip.getModeData(mode), sizeof(lineBuffer)/sizeof(char)-1);
+    lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
+    if (lineBuffer[0] != 0) {
+      char* startPtr = strrchr(lineBuffer, ';'); // last ";" in FX data
+      if (!startPtr) return -1;
+
+      char* stopPtr = strstr(startPtr, segVar);
+      if (!stopPtr) return -1;
+
+      stopPtr += strlen(segVar) +1; // skip "="
+      return atoi(stopPtr);
+    }
+  }
+  return -1;
+}
+
+uint16_t crc16(const unsigned char* data_p, size_t length) {
+  uint8_t x;
+  uint16_t crc = 0xFFFF;
+  if (!length) return 0x1D0F;
+  while (length--) {
+    x = crc >> 8 ^ *data_p++;
+    x ^= x>>4;
+    crc = (crc << 8) ^ ((uint16_t)(x << 12)) ^ ((uint16_t)(x <<5)) ^ ((uint16_t)x);
+  }
+  return crc;
+}
+
+// same data layout and simulation as util.cpp so audio reactive effects render identically
+um_data_t* simulateSound(uint8_t simulationId)
+{
+  static uint8_t samplePeak;
+  static float   FFT_MajorPeak;
+  static uint8_t maxVol;
+  static uint8_t binNum;
+
+  static float    volumeSmth;
+  static uint16_t volumeRaw;
+  static float    my_magnitude;
+
+  //arrays
+  uint8_t *fftResult;
+
+  static um_data_t* um_data = nullptr;
+
+  if (!um_data) {
+    //claim storage for arrays
+    fftResult = (uint8_t *)malloc(sizeof(uint8_t) * 16);
+
+    um_data = new um_data_t;
+    um_data->u_size = 8;
+    um_data->u_type = new um_types_t[um_data->u_size];
+    um_data->u_data = new void*[um_data->u_size];
+    um_data->u_data[0] = &volumeSmth;
+    um_data->u_data[1] = &volumeRaw;
+    um_data->u_data[2] = fftResult;
+    um_data->u_data[3] = &samplePeak;
+    um_data->u_data[4] = &FFT_MajorPeak;
+    um_data->u_data[5] = &my_magnitude;
+    um_data->u_data[6] = &maxVol;
+    um_data->u_data[7] = &binNum;
+  } else {
+    // get arrays from um_data
+    fftResult =  (uint8_t*)um_data->u_data[2];
+  }
+
+  uint32_t ms = millis();
+
+  switch (simulationId) {
+    default:
+    case 0: // UMS_BeatSin
+      for (int i = 0; i<16; i++)
+        fftResult[i] = beatsin8(120 / (i+1), 0, 255);
+      volumeSmth = fftResult[8];
+      break;
+    case 1: // UMS_WeWillRockYou
+      if (ms%2000 < 200) {
+        volumeSmth = random8(255);
+        for (int i = 0; i<5; i++)
+          fftResult[i] = random8(255);
+      }
+      else if (ms%2000 < 400) {
+        volumeSmth = 0;
+        for (int i = 0; i<16; i++)
+          fftResult[i] = 0;
+      }
+      else if (ms%2000 < 600) {
+        volumeSmth = random8(255);
+        for (int i = 5; i<11; i++)
+          fftResult[i] = random8(255);
+      }
+      else if (ms%2000 < 800) {
+        volumeSmth = 0;
+        for (int i = 0; i<16; i++)
+          fftResult[i] = 0;
+      }
+      else if (ms%2000 < 1000) {
+        volumeSmth = random8(255);
+        for (int i = 11; i<16; i++)
+          fftResult[i] = random8(255);
+      }
+      else {
+        volumeSmth = 0;
+        for (int i = 0; i<16; i++)
+          fftResult[i] = 0;
+      }
+      break;
+    case 2: // UMS_10_13
+      for (int i = 0; i<16; i++)
+        fftResult[i] = inoise8(beatsin8(90 / (i+1), 0, 200)*15 + (ms>>10), ms>>3);
+      volumeSmth = fftResult[8];
+      break;
+    case 3: // UMS_14_3
+      for (int i = 0; i<16; i++)
+        fftResult[i] = inoise8(beatsin8(120 / (i+1), 10, 30)*10 + (ms>>14), ms>>3);
+      volumeSmth = fftResult[8];
+      break;
+  }
+
+  samplePeak    = random8() > 250;
+  FFT_MajorPeak = 21 + (volumeSmth*volumeSmth) / 8.0f;
+  maxVol        = 31;
+  binNum        = 8;
+  volumeRaw     = volumeSmth;
+  my_magnitude  = 10000.0f / 8.0f;
+  if (volumeSmth < 1 ) my_magnitude = 0.001f;
+
+  return um_data;
+}
+
+uint8_t get_random_wheel_index(uint8_t pos) {
+  uint8_t r = 0, x = 0, y = 0, d = 0;
+  while (d < 42) {
+    r = random8();
+    x = abs(pos - r);
+    y = 255 - x;
+    d = MIN(x, y);
+  }
+  return r;
+}
+
+// no filesystem, so there are never any ledmaps to enumerate
+void enumerateLedmaps() {}
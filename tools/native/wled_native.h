@@ -0,0 +1,190 @@
+#ifndef WLED_NATIVE_H
+#define WLED_NATIVE_H
+
+/*
+ * Stand-in for wled.h in the host (env:native) build.
+ * It is force-included (-include wled_native.h) so the real wled.h and fcn_declare.h,
+ * which pull in the network, filesystem and web server stacks, are skipped via their
+ * include guards. Only what the effect engine needs is declared here; definitions
+ * live in wled_native.cpp.
+ */
+
+#define WLED_H
+#define WLED_FCN_DECLARE_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+
+#define ARDUINOJSON_DECODE_UNICODE 0
+#define ARDUINOJSON_ENABLE_PROGMEM 1
+#define ARDUINOJSON_ENABLE_ARDUINO_STRING 0
+#define ARDUINOJSON_ENABLE_ARDUINO_STREAM 0
+#define ARDUINOJSON_ENABLE_ARDUINO_PRINT 0
+#include "src/dependencies/json/ArduinoJson-v6.h"
+#include "src/dependencies/time/TimeLib.h"
+#include "src/dependencies/toki/Toki.h"
+
+#include "const.h"
+
+#ifndef WLED_VERSION
+  #define WLED_VERSION "native"
+#endif
+
+#define DEBUG_PRINT(x)
+#define DEBUG_PRINTLN(x)
+#define DEBUG_PRINTF(x...)
+#define DEBUGFS_PRINT(x)
+#define DEBUGFS_PRINTLN(x)
+#define DEBUGFS_PRINTF(x...)
+
+#define SET_F(x)  (const char*)F(x)
+
+//color mangling macros
+#define RGBW32(r,g,b,w) (uint32_t((byte(w) << 24) | (byte(r) << 16) | (byte(g) << 8) | (byte(b))))
+#define R(c) (byte((c) >> 16))
+#define G(c) (byte((c) >> 8))
+#define B(c) (byte(c))
+#define W(c) (byte((c) >> 24))
+
+// filesystem: nothing is persisted on the host, so ledmaps/palettes/gaps are never found
+struct NativeFS {
+  bool exists(const char *) { return false; }
+};
+extern NativeFS WLED_FS;
+
+//colors.cpp (see fcn_declare.h)
+class NeoGammaWLEDMethod {
+  public:
+    static uint8_t Correct(uint8_t value);
+    static uint32_t Correct32(uint32_t color);
+    static void calcGammaTable(float gamma);
+    static inline uint8_t rawGamma8(uint8_t val) { return gammaT[val]; }
+  private:
+    static uint8_t gammaT[];
+};
+#define gamma32(c) NeoGammaWLEDMethod::Correct32(c)
+#define gamma8(c)  NeoGammaWLEDMethod::rawGamma8(c)
+uint32_t color_blend(uint32_t,uint32_t,uint16_t,bool b16=false);
+uint32_t color_add(uint32_t,uint32_t, bool fast=false);
+uint32_t color_fade(uint32_t c1, uint8_t amount, bool video=false);
+inline uint32_t colorFromRgbw(byte* rgbw) { return uint32_t((byte(rgbw[3]) << 24) | (byte(rgbw[0]) << 16) | (byte(rgbw[1]) << 8) | (byte(rgbw[2]))); }
+void colorHStoRGB(uint16_t hue, byte sat, byte* rgb);
+void colorKtoRGB(uint16_t kelvin, byte* rgb);
+void colorCTtoRGB(uint16_t mired, byte* rgb);
+void colorXYtoRGB(float x, float y, byte* rgb);
+void colorRGBtoXY(byte* rgb, float* xy);
+void colorFromDecOrHexString(byte* rgb, char* in);
+bool colorFromHexString(byte* rgb, const char* in);
+uint32_t colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb);
+uint16_t approximateKelvinFromRGB(uint32_t rgb);
+void setRandomColor(byte* rgb);
+
+//file.cpp
+bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest);
+
+//udp.cpp
+byte *realtimeBroadcastPacket(uint8_t type, bool isRGBW);
+uint8_t realtimeBroadcast(uint8_t type, const IPAddress *clients, uint8_t numClients, uint16_t universe, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW, byte *packet);
+void realtimeBroadcastSync(const IPAddress *clients, uint8_t numClients);
+int realtimeInputIndex(uint8_t universe, uint8_t pixel);
+
+//um_manager.cpp
+typedef enum UM_Data_Types {
+  UMT_BYTE = 0,
+  UMT_UINT16,
+  UMT_INT16,
+  UMT_UINT32,
+  UMT_INT32,
+  UMT_FLOAT,
+  UMT_DOUBLE,
+  UMT_BYTE_ARR,
+  UMT_UINT16_ARR,
+  UMT_INT16_ARR,
+  UMT_UINT32_ARR,
+  UMT_INT32_ARR,
+  UMT_FLOAT_ARR,
+  UMT_DOUBLE_ARR
+} um_types_t;
+typedef struct UM_Exchange_Data {
+  size_t       u_size;
+  um_types_t  *u_type;
+  void       **u_data;
+  UM_Exchange_Data() {
+    u_size = 0;
+    u_type = nullptr;
+    u_data = nullptr;
+  }
+  ~UM_Exchange_Data() {
+    if (u_type) delete[] u_type;
+    if (u_data) delete[] u_data;
+  }
+} um_data_t;
+
+// no usermods on the host: audio reactive effects fall back to simulateSound()
+class UsermodManager {
+  public:
+    bool getUMData(um_data_t **um_data, uint8_t mod_id = USERMOD_ID_RESERVED) { return false; }
+    void handleOverlayDraw() {}
+};
+extern UsermodManager usermods;
+
+//util.cpp
+bool requestJSONBufferLock(uint8_t module=255);
+void releaseJSONBufferLock();
+um_data_t* simulateSound(uint8_t simulationId);
+uint8_t get_random_wheel_index(uint8_t pos);
+uint16_t crc16(const unsigned char* data_p, size_t length);
+int16_t extractModeDefaults(uint8_t mode, const char *segVar);
+void enumerateLedmaps();
+
+//wled_math.cpp
+#ifndef WLED_USE_REAL_MATH
+  template <typename T> T atan_t(T x);
+  float cos_t(float phi);
+  float sin_t(float x);
+  float tan_t(float x);
+  float acos_t(float x);
+  float asin_t(float x);
+  float floor_t(float x);
+  float fmod_t(float num, float denom);
+#else
+  #include <math.h>
+  #define sin_t sin
+  #define cos_t cos
+  #define tan_t tan
+  #define asin_t asin
+  #define acos_t acos
+  #define atan_t atan
+  #define fmod_t fmod
+  #define floor_t floor
+#endif
+
+#include "pin_manager.h"
+#include "bus_manager.h"
+#include "FX.h"
+
+// globals used by the effect engine (see wled.h, defined in wled_native.cpp)
+extern bool autoSegments;
+extern bool useGlobalLedBuffer;
+extern bool correctWB;
+extern bool cctFromRgb;
+extern bool gammaCorrectCol;
+extern bool gammaCorrectBri;
+extern float gammaCorrectVal;
+extern bool fadeTransition;
+extern bool modeBlending;
+extern uint8_t randomPaletteChangeTime;
+extern bool stateChanged;
+extern bool useAMPM;
+extern byte realtimeMode;
+extern time_t localTime;
+extern byte errorFlag;
+extern byte lastRandomIndex;
+extern char *ledmapNames[WLED_MAX_LEDMAPS-1];
+extern StaticJsonDocument<JSON_BUFFER_SIZE> doc;
+extern Toki toki;
+extern BusConfig* busConfigs[WLED_MAX_BUSSES+WLED_MIN_VIRTUAL_BUSSES];
+extern BusManager busses;
+extern WS2812FX strip;
+
+#endif
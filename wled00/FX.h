@@ -79,12 +79,37 @@
   #endif
 #endif
 
+/* number of built palettes kept for reuse (~60 bytes each) */
+#ifndef WLED_PALETTE_CACHE_SIZE
+  #ifdef ESP8266
+    #define WLED_PALETTE_CACHE_SIZE 4
+  #else
+    #define WLED_PALETTE_CACHE_SIZE 8
+  #endif
+#endif
+
+/* How much data bytes all segments combined may allocate for buffered mode blending (2 buffers of 4 bytes per LED
+  in transition). If a segment does not fit, its modes are blended against the strip pixels instead. */
+#ifndef MAX_BLEND_DATA
+  #ifdef ESP8266
+    #define MAX_BLEND_DATA  0
+  #elif defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+    #define MAX_BLEND_DATA  262144
+  #else
+    #define MAX_BLEND_DATA  16384
+  #endif
+#endif
+
 /* How much data bytes each segment should max allocate to leave enough space for other segments,
   assuming each segment uses the same amount of data. 256 for ESP8266, 640 for ESP32. */
 #define FAIR_DATA_PER_SEG (MAX_SEGMENT_DATA / strip.getMaxSegments())
 
 #define MIN_SHOW_DELAY   (_frametime < 16 ? 8 : 15)
 
+// lockstep effect sync (see WS2812FX::service())
+#define LOCKSTEP_MAX_CATCHUP  8   // missed frames rendered at once by a node that fell behind, more are skipped
+#define LOCKSTEP_CHECK_FRAMES 256 // frames between effect state checkpoints compared across nodes
+
 #define NUM_COLORS       3 /* number of colors per segment */
 #define SEGMENT          strip._segments[strip.getCurrSegmentId()]
 #define SEGENV           strip._segments[strip.getCurrSegmentId()]
@@ -314,8 +339,9 @@
 #define FX_MODE_WAVESINS               184
 #define FX_MODE_ROCKTAVES              185
 #define FX_MODE_2DAKEMI                186
+#define FX_MODE_REALTIME               187
 
-#define MODE_COUNT                     187
+#define MODE_COUNT                     188
 
 typedef enum mapping1D2D {
   M12_Pixels = 0,
@@ -400,6 +426,13 @@ typedef struct Segment {
     } tmpsegd_t;
 
   private:
+    // specialized pixel writers, no option checks per pixel
+    template<bool REVERSED> static void setPixel1D(Segment &seg, int i, uint32_t c);  // no grouping, spacing or mirroring
+  #ifndef WLED_DISABLE_2D
+    template<bool GROUPED>  static void setPixel2D(Segment &seg, int x, int y, uint32_t c); // no reverse, transpose or mirroring
+  #endif
+    void selectPixelWriters(void);
+
     union {
       uint8_t  _capabilities;
       struct {
@@ -411,15 +444,42 @@ typedef struct Segment {
       };
     };
     uint16_t        _dataLen;
+    // render context, refreshed by updateRenderContext() once per frame before the effect is run
+    // and outside service() once per call of the functions that paint the whole segment
+    uint16_t        _vLength;  // virtualLength()
+    uint16_t        _pxFirst;  // physical index of the first LED of virtual pixel 0 (reverse/mirror applied, offset not)
+    uint16_t        _blendT;   // weight of the underlying pixel when blending modes (0xFFFF - progress())
+    uint8_t         _segBri;   // currentBri()
+    bool            _renderDirty; // geometry, options, brightness or transition changed since the last refresh
+    uint32_t        _palScale; // ceil(255<<24 / (_vLength-1)) to map pixels onto the palette without division, 0 if too long (see paletteIndex())
+    // pixel writers specialized for the segment's geometry, nullptr if options need the generic path (see selectPixelWriters())
+    void          (*_pixelWriter)(Segment &seg, int i, uint32_t c);
+  #ifndef WLED_DISABLE_2D
+    void          (*_pixelWriterXY)(Segment &seg, int x, int y, uint32_t c);
+  #endif
     static uint16_t _usedSegmentData;
 
     // perhaps this should be per segment, not static
     static CRGBPalette16 _currentPalette;     // palette used for current effect (includes transition, used in color_from_palette())
+    static CRGB          _paletteLUT[256];    // _currentPalette expanded to all 256 indices, entries are filled on first use
+    static uint32_t      _paletteLUTValid[8]; // one bit per _paletteLUT entry, cleared by setCurrentPalette()
+    static bool          _paletteNoBlend;     // strip.paletteBlend == 3 when the LUT was started
     static CRGBPalette16 _randomPalette;      // actual random palette
     static CRGBPalette16 _newRandomPalette;   // target random palette
     static unsigned long _lastPaletteChange;  // last random palette change time in millis()
+    // recently built color/gradient palettes, shared by all segments (see loadPalette())
+    struct PaletteCacheEntry {
+      uint32_t      colors[3];  // segment colors the palette was built from (palettes 2-5 only, 0 otherwise)
+      uint16_t      used;       // _paletteCacheTick when last used (LRU replacement)
+      uint8_t       pal;        // palette ID, 0 if entry is unused
+      bool          gamma;      // gammaCorrectCol when built (palettes 2-5 only)
+      CRGBPalette16 palette;
+    };
+    static PaletteCacheEntry _paletteCache[WLED_PALETTE_CACHE_SIZE];
+    static uint16_t          _paletteCacheTick;
     #ifndef WLED_DISABLE_MODE_BLEND
     static bool          _modeBlend;          // mode/effect blending semaphore
+    static size_t        _usedBlendData;      // amount of RAM all segments use for blend buffers
     #endif
 
     // transition data, valid only if transitional==true, holds values during transition (72 bytes)
@@ -427,6 +487,9 @@ typedef struct Segment {
       #ifndef WLED_DISABLE_MODE_BLEND
       tmpsegd_t     _segT;        // previous segment environment
       uint8_t       _modeT;       // previous mode/effect
+      uint32_t     *_pixOld;      // pixels of previous mode (buffered blending only)
+      uint32_t     *_pixNew;      // pixels of current mode (buffered blending only)
+      uint16_t      _pixLen;      // length of each pixel buffer
       #else
       uint32_t      _colorT[NUM_COLORS];
       #endif
@@ -437,7 +500,14 @@ typedef struct Segment {
       unsigned long _start;       // must accommodate millis()
       uint16_t      _dur;
       Transition(uint16_t dur=750)
+        #ifndef WLED_DISABLE_MODE_BLEND
+        : _pixOld(nullptr)
+        , _pixNew(nullptr)
+        , _pixLen(0)
+        , _palT(CRGBPalette16(CRGB::Black))
+        #else
         : _palT(CRGBPalette16(CRGB::Black))
+        #endif
         , _prevPaletteBlends(0)
         , _start(millis())
         , _dur(dur)
@@ -477,6 +547,16 @@ typedef struct Segment {
       data(nullptr),
       _capabilities(0),
       _dataLen(0),
+      _vLength(sStop > sStart ? sStop - sStart : 0),
+      _pxFirst(sStart),
+      _blendT(0),
+      _segBri(255),
+      _renderDirty(true),
+      _palScale(0),
+      _pixelWriter(nullptr),
+    #ifndef WLED_DISABLE_2D
+      _pixelWriterXY(nullptr),
+    #endif
       _t(nullptr)
     {
       #ifdef WLED_DEBUG
@@ -531,6 +611,7 @@ typedef struct Segment {
     static void     modeBlend(bool blend)       { _modeBlend = blend; }
     #endif
     static void     handleRandomPalette();
+    static void     invalidatePaletteCache();
     inline static const CRGBPalette16 &getCurrentPalette(void) { return Segment::_currentPalette; }
 
     void    setUp(uint16_t i1, uint16_t i2, uint8_t grp=1, uint8_t spc=0, uint16_t ofs=UINT16_MAX, uint16_t i1Y=0, uint16_t i2Y=1, uint8_t segId = 255);
@@ -542,6 +623,9 @@ typedef struct Segment {
     void    setPalette(uint8_t pal);
     uint8_t differs(Segment& b) const;
     void    refreshLightCapabilities(void);
+    void    updateRenderContext(void);
+    inline void markRenderDirty(void) { _renderDirty = true; } // after changing geometry or options directly
+    uint32_t writtenColor(uint32_t old, uint32_t c) const; // color setPixelColor() leaves in a pixel that held old
 
     // runtime data functions
     inline uint16_t dataSize(void) const { return _dataLen; }
@@ -563,12 +647,18 @@ typedef struct Segment {
     #ifndef WLED_DISABLE_MODE_BLEND
     void     swapSegenv(tmpsegd_t &tmpSegD);
     void     restoreSegenv(tmpsegd_t &tmpSegD);
+    bool     allocateBlendBuffers(void);              // separate pixel buffers for previous and current mode, false if out of memory
+    void     deallocateBlendBuffers(void);
+    void     copyBlendBuffer(bool prev, bool toStrip); // moves a mode's pixels between its buffer and the segment's strip area
+    void     compositeBlendBuffers(void);             // writes the cross-fade of both buffers to the strip
     #endif
     uint16_t progress(void); //transition progression between 0-65535
     uint8_t  currentBri(bool useCct = false);
     uint8_t  currentMode(void);
     uint32_t currentColor(uint8_t slot);
     CRGBPalette16 &loadPalette(CRGBPalette16 &tgt, uint8_t pal);
+    uint8_t  paletteIndex(uint16_t i, bool mapping, bool wrap) const;
+    static uint32_t paletteColor(uint8_t index, uint8_t pbri = 255);
     void     setCurrentPalette(void);
 
     // 1D strip
@@ -593,6 +683,7 @@ typedef struct Segment {
     void addPixelColor(int n, CRGB c, bool fast = false)          { addPixelColor(n, RGBW32(c.r,c.g,c.b,0), fast); } // automatically inline
     void fadePixelColor(uint16_t n, uint8_t fade);
     uint32_t color_from_palette(uint16_t, bool mapping, bool wrap, uint8_t mcol, uint8_t pbri = 255);
+    void     fillPalette(uint16_t first, uint16_t count, bool wrap, uint8_t mcol, uint8_t pbri = 255); // same as setPixelColor(i, color_from_palette(i, true, ...)) for each pixel of the span
     uint32_t color_wheel(uint8_t pos);
 
     // 2D matrix
@@ -609,6 +700,9 @@ typedef struct Segment {
     void setPixelColorXY(float x, float y, byte r, byte g, byte b, byte w = 0, bool aa = true) { setPixelColorXY(x, y, RGBW32(r,g,b,w), aa); }
     void setPixelColorXY(float x, float y, CRGB c, bool aa = true)                             { setPixelColorXY(x, y, RGBW32(c.r,c.g,c.b,0), aa); }
     uint32_t getPixelColorXY(uint16_t x, uint16_t y);
+    void getLineXY(uint16_t i, bool vertical, uint32_t *buf);       // reads row i (column i if vertical) of the segment in one pass
+    void setLineXY(uint16_t i, bool vertical, const uint32_t *buf); // writes a line as is (no brightness scaling), counterpart of getLineXY()
+    void setGroupXY(int x, int y, uint32_t c);                      // writes physical pixel x,y (relative to segment) with its group and mirrored pixels
     // 2D support functions
     void blendPixelColorXY(uint16_t x, uint16_t y, uint32_t color, uint8_t blend);
     void blendPixelColorXY(uint16_t x, uint16_t y, CRGB c, uint8_t blend)  { blendPixelColorXY(x, y, RGBW32(c.r,c.g,c.b,0), blend); }
@@ -688,8 +782,10 @@ class WS2812FX {  // 96 bytes
       cctBlending(0),
       ablMilliampsMax(ABL_MILLIAMPS_DEFAULT),
       currentMilliamps(0),
+      lockstepSeed(0),
       now(millis()),
       timebase(0),
+      lockstep(false),
       isMatrix(false),
 #ifndef WLED_DISABLE_2D
       panels(1),
@@ -708,8 +804,14 @@ class WS2812FX {  // 96 bytes
       _isOffRefreshRequired(false),
       _hasWhiteChannel(false),
       _triggered(false),
+      _hasCCTBus(false),
+      _directBusWrite(false),
       _modeCount(MODE_COUNT),
       _callback(nullptr),
+      _pixels(nullptr),
+      _realtimeInput(nullptr),
+      _realtimeInputLen(0),
+      _hasRealtimeSegments(false),
       customMappingTable(nullptr),
       customMappingSize(0),
       _lastShow(0),
@@ -722,7 +824,15 @@ class WS2812FX {  // 96 bytes
       _qStopY(0),
       _qGrouping(0),
       _qSpacing(0),
-      _qOffset(0)
+      _qOffset(0),
+      _lockstepActive(false),
+      _lockstepDiverged(false),
+      _lockstepFrame(0),
+      _lockstepResetFrame(0),
+      _lockstepCheckFrame(0),
+      _lockstepCheckHash(0),
+      _lockstepRemoteFrame(0),
+      _lockstepRemoteHash(0)
     {
       WS2812FX::instance = this;
       _mode.reserve(_modeCount);     // allocate memory to prevent initial fragmentation (does not increase size())
@@ -732,6 +842,8 @@ class WS2812FX {  // 96 bytes
     }
 
     ~WS2812FX() {
+      if (_pixels) free(_pixels);
+      if (_realtimeInput) free(_realtimeInput);
       if (customMappingTable) delete[] customMappingTable;
       _mode.clear();
       _modeData.clear();
@@ -743,6 +855,7 @@ class WS2812FX {  // 96 bytes
     }
 
     static WS2812FX* getInstance(void) { return instance; }
+    static uint32_t frameBufferMem(uint16_t len); // internal RAM used by a frame buffer of len pixels (none if it goes to PSRAM)
 
     void
 #ifdef WLED_DEBUG
@@ -764,11 +877,18 @@ class WS2812FX {  // 96 bytes
       makeAutoSegments(bool forceReset = false),
       fixInvalidSegments(),
       setPixelColor(int n, uint32_t c),
+      setPixels(uint16_t i, const uint32_t *c, uint16_t count), // set count consecutive pixels at once
+      commitPixelSpan(uint16_t i, uint16_t count), // call after writing pixels through getPixelSpan()
+      fill(uint32_t c), // fill whole strip with color
       show(void),
-      setTargetFps(uint8_t fps);
+      setTargetFps(uint8_t fps),
+      lockstepResync(uint32_t frame),                    // restart all effects at this shared frame
+      lockstepCheckpoint(uint32_t frame, uint32_t hash), // effect state checkpoint of another node
+      updateRealtimeSegments(uint16_t inputLen),
+      setRealtimeInput(uint16_t i, const uint32_t *c, uint16_t count), // realtime pixels for the "Realtime" effect
+      clearRealtimeInput(void);
 
     void setColor(uint8_t slot, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) { setColor(slot, RGBW32(r,g,b,w)); }
-    void fill(uint32_t c) { for (int i = 0; i < getLengthTotal(); i++) setPixelColor(i, c); } // fill whole strip with color (inline)
     void addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name); // add effect to the list; defined in FX.cpp
     void setupEffectData(void); // add default effects to the list; defined in FX.cpp
 
@@ -789,8 +909,20 @@ class WS2812FX {  // 96 bytes
       deserializeMap(uint8_t n=0);
 
     inline bool isServicing(void) { return _isServicing; }
+    // frame buffer of count pixels from i for writing in place, nullptr if there is no buffer or a ledmap applies
+    inline uint32_t* getPixelSpan(uint16_t i, uint16_t count) { return (_pixels && i >= customMappingSize && i + count <= _length) ? _pixels + i : nullptr; }
     inline bool hasWhiteChannel(void) {return _hasWhiteChannel;}
     inline bool isOffRefreshRequired(void) {return _isOffRefreshRequired;}
+    inline bool isLockstepActive(void) { return _lockstepActive; }
+    // time for effect intervals and elapsed times: the shared frame time in lockstep, otherwise millis()
+    // (unlike now it does not jump when the timebase changes), effect phases use now
+    inline unsigned long effectMillis(void) { return _lockstepActive ? now : millis(); }
+    // realtime input goes to segments running the "Realtime" effect instead of the whole strip
+    inline bool hasRealtimeSegments(void) { return _hasRealtimeSegments; }
+    inline const uint32_t* getRealtimeInput(void) { return _realtimeInput; } // by realtime pixel index
+    inline uint16_t getRealtimeInputLength(void) { return _realtimeInputLen; }
+    // true once after our state was found to differ from another node's checkpoint
+    inline bool lockstepDiverged(void) { bool d = _lockstepDiverged; _lockstepDiverged = false; return d; }
 
     uint8_t
       paletteFade,
@@ -824,12 +956,18 @@ class WS2812FX {  // 96 bytes
     inline uint16_t getLength(void) { return _length; } // 2D matrix may have less pixels than W*H
     inline uint16_t getTransition(void) { return _transitionDur; }
 
+    uint16_t
+      lockstepSeed; // random number seed shared by all lockstep nodes
+
     uint32_t
       now,
       timebase,
       getPixelColor(uint16_t);
 
     inline uint32_t getLastShow(void) { return _lastShow; }
+    inline uint32_t getLockstepFrame(void) { return _lockstepFrame; }           // last rendered shared frame
+    inline uint32_t getLockstepCheckFrame(void) { return _lockstepCheckFrame; } // last checkpoint
+    inline uint32_t getLockstepCheckHash(void) { return _lockstepCheckHash; }
     inline uint32_t segColor(uint8_t i) { return _colors_t[i]; }
 
     const char *
@@ -843,6 +981,9 @@ class WS2812FX {  // 96 bytes
     inline Segment& getMainSegment(void)      { return _segments[getMainSegmentId()]; }
     inline Segment* getSegments(void)         { return &(_segments[0]); }
 
+    bool
+      lockstep; // render frames of a clock shared through NTP with frame based time and random numbers
+
   // 2D support (panels)
     bool
       isMatrix;
@@ -914,6 +1055,8 @@ class WS2812FX {  // 96 bytes
       bool _isOffRefreshRequired : 1; //periodic refresh is required for the strip to remain off.
       bool _hasWhiteChannel      : 1;
       bool _triggered            : 1;
+      bool _hasCCTBus            : 1; // at least one bus takes CCT from the segment
+      bool _directBusWrite       : 1; // per-segment CCT must be applied when writing, bypass the frame buffer flush
     };
 
     uint8_t                  _modeCount;
@@ -922,6 +1065,11 @@ class WS2812FX {  // 96 bytes
 
     show_callback _callback;
 
+    uint32_t* _pixels; // frame buffer (physical order, _length entries) if useGlobalLedBuffer is set, pushed to busses in show()
+    uint32_t* _realtimeInput;  // last realtime pixels received while segments run the "Realtime" effect
+    uint16_t  _realtimeInputLen;
+    bool      _hasRealtimeSegments;
+
     uint16_t* customMappingTable;
     uint16_t  customMappingSize;
 
@@ -934,10 +1082,18 @@ class WS2812FX {  // 96 bytes
     uint8_t _qGrouping, _qSpacing;
     uint16_t _qOffset;
 
+    bool     _lockstepActive;   // lockstep is enabled and toki has a millisecond accurate time
+    bool     _lockstepDiverged;
+    uint32_t _lockstepFrame;
+    uint32_t _lockstepResetFrame;
+    uint32_t _lockstepCheckFrame, _lockstepCheckHash;
+    uint32_t _lockstepRemoteFrame, _lockstepRemoteHash; // checkpoint of another node we have not reached yet
+
     uint8_t
       estimateCurrentAndLimitBri(void);
 
     void
+      flushPixels(void),
       setUpSegmentFromQueuedChanges(void);
 };
 
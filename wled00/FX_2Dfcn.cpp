@@ -173,9 +173,11 @@ uint16_t IRAM_ATTR Segment::XY(uint16_t x, uint16_t y)
 void IRAM_ATTR Segment::setPixelColorXY(int x, int y, uint32_t col)
 {
   if (!isActive()) return; // not active
+  if (_renderDirty) updateRenderContext(); // segment has been changed since the last refresh
+  if (_pixelWriterXY) { _pixelWriterXY(*this, x, y, col); return; }
   if (x >= virtualWidth() || y >= virtualHeight() || x<0 || y<0) return;  // if pixel would fall out of virtual segment just exit
 
-  uint8_t _bri_t = currentBri();
+  uint8_t _bri_t = _segBri;
   if (_bri_t < 255) {
     byte r = scale8(R(col), _bri_t);
     byte g = scale8(G(col), _bri_t);
@@ -192,6 +194,11 @@ void IRAM_ATTR Segment::setPixelColorXY(int x, int y, uint32_t col)
   y *= groupLength(); // expand to physical pixels
   if (x >= width() || y >= height()) return;  // if pixel would fall out of segment just exit
 
+  setGroupXY(x, y, col);
+}
+
+void IRAM_ATTR Segment::setGroupXY(int x, int y, uint32_t col)
+{
   uint32_t tmpCol = col;
   for (int j = 0; j < grouping; j++) {   // groupping vertically
     for (int g = 0; g < grouping; g++) { // groupping horizontally
@@ -200,7 +207,7 @@ void IRAM_ATTR Segment::setPixelColorXY(int x, int y, uint32_t col)
 
 #ifndef WLED_DISABLE_MODE_BLEND
       // if blending modes, blend with underlying pixel
-      if (_modeBlend) tmpCol = color_blend(strip.getPixelColorXY(start + xX, startY + yY), col, 0xFFFFU - progress(), true);
+      if (_modeBlend) tmpCol = color_blend(strip.getPixelColorXY(start + xX, startY + yY), col, _blendT, true);
 #endif
 
       strip.setPixelColorXY(start + xX, startY + yY, tmpCol);
@@ -220,6 +227,30 @@ void IRAM_ATTR Segment::setPixelColorXY(int x, int y, uint32_t col)
   }
 }
 
+// 2D segment without reverse, transpose or mirroring, with (GROUPED) or without grouping/spacing
+// x < virtualWidth() holds exactly when x*groupLength() < width(), so bounds are checked on physical pixels
+template<bool GROUPED> void IRAM_ATTR Segment::setPixel2D(Segment &seg, int x, int y, uint32_t col)
+{
+  if (x<0 || y<0) return;
+  const int cols = seg.width();
+  const int rows = seg.height();
+  if (GROUPED) {
+    x *= seg.groupLength(); // expand to physical pixels
+    y *= seg.groupLength(); // expand to physical pixels
+  }
+  if (x >= cols || y >= rows) return; // if pixel would fall out of segment just exit
+  if (seg._segBri < 255) col = color_fade(col, seg._segBri);
+  if (!GROUPED) {
+    strip.setPixelColorXY(seg.start + x, seg.startY + y, col);
+    return;
+  }
+  for (int j = 0; j < seg.grouping && y+j < rows; j++)   // groupping vertically
+    for (int g = 0; g < seg.grouping && x+g < cols; g++) // groupping horizontally
+      strip.setPixelColorXY(seg.start + x + g, seg.startY + y + j, col);
+}
+template void Segment::setPixel2D<false>(Segment &seg, int x, int y, uint32_t col);
+template void Segment::setPixel2D<true>(Segment &seg, int x, int y, uint32_t col);
+
 // anti-aliased version of setPixelColorXY()
 void Segment::setPixelColorXY(float x, float y, uint32_t col, bool aa)
 {
@@ -277,6 +308,48 @@ uint32_t Segment::getPixelColorXY(uint16_t x, uint16_t y) {
   return strip.getPixelColorXY(start + x, startY + y);
 }
 
+// Geometry of a row (or column) of the virtual segment: physical position (relative to the segment)
+// of its first pixel and the step to the next one, with reverse, transpose and grouping applied.
+static void lineGeometry(const Segment &seg, uint16_t i, bool vertical, int &x, int &y, int &dx, int &dy)
+{
+  const int g = seg.groupLength();
+  x = vertical ? i : 0; dx = !vertical;
+  y = vertical ? 0 : i; dy = vertical;
+  if (seg.reverse)   { x = seg.virtualWidth()  - x - 1; dx = -dx; }
+  if (seg.reverse_y) { y = seg.virtualHeight() - y - 1; dy = -dy; }
+  if (seg.transpose) { std::swap(x, y); std::swap(dx, dy); }
+  x *= g; dx *= g;
+  y *= g; dy *= g;
+}
+
+// same as getPixelColorXY() for every pixel of the line but the segment geometry is only resolved once
+void Segment::getLineXY(uint16_t i, bool vertical, uint32_t *buf)
+{
+  const unsigned len = vertical ? virtualHeight() : virtualWidth();
+  int x, y, dx, dy;
+  lineGeometry(*this, i, vertical, x, y, dx, dy);
+  x += start; y += startY;
+  for (unsigned j = 0; j < len; j++, x += dx, y += dy) buf[j] = strip.getPixelColorXY(x, y);
+}
+
+// colors are written as they are: lines read with getLineXY() are already scaled by segment brightness
+void Segment::setLineXY(uint16_t i, bool vertical, const uint32_t *buf)
+{
+  const unsigned len = vertical ? virtualHeight() : virtualWidth();
+  int x, y, dx, dy;
+  lineGeometry(*this, i, vertical, x, y, dx, dy);
+  bool single = grouping == 1 && !mirror && !mirror_y; // each virtual pixel is one physical pixel
+#ifndef WLED_DISABLE_MODE_BLEND
+  single &= !_modeBlend;
+#endif
+  if (single) {
+    x += start; y += startY;
+    for (unsigned j = 0; j < len; j++, x += dx, y += dy) strip.setPixelColorXY(x, y, buf[j]);
+  } else {
+    for (unsigned j = 0; j < len; j++, x += dx, y += dy) setGroupXY(x, y, buf[j]);
+  }
+}
+
 // Blends the specified color with the existing pixel color.
 void Segment::blendPixelColorXY(uint16_t x, uint16_t y, uint32_t color, uint8_t blend) {
   setPixelColorXY(x, y, color_blend(getPixelColorXY(x,y), color, blend));
@@ -294,6 +367,45 @@ void Segment::fadePixelColorXY(uint16_t x, uint16_t y, uint8_t fade) {
   setPixelColorXY(x, y, color_fade(getPixelColorXY(x,y), fade, true));
 }
 
+// Line kernels work on a row or column read with getLineXY() and written back with setLineXY().
+// Colors in the line are what getPixelColorXY() would return, so anything the former pixel by pixel
+// code wrote and read back again is scaled by segment brightness here (scale8() by 255 is a no-op).
+// Each pass is free of loop-carried dependencies so the compiler may vectorize it.
+static inline uint32_t scaleRGB(uint32_t c, uint8_t s) // W is dropped, as with CRGB
+{
+  return (scale8(c >> 16, s) << 16) | (scale8(c >> 8, s) << 8) | scale8(c, s);
+}
+
+static inline uint32_t addRGB(uint32_t c1, uint32_t c2) // saturating, as CRGB::operator+=
+{
+  return (qadd8(c1 >> 16, c2 >> 16) << 16) | (qadd8(c1 >> 8, c2 >> 8) << 8) | qadd8(c1, c2);
+}
+
+static void scaleLine(uint32_t *line, unsigned len, uint8_t bri)
+{
+  if (bri == 255) return;
+  for (unsigned j = 0; j < len; j++) {
+    uint32_t c = line[j];
+    line[j] = RGBW32(scale8(R(c), bri), scale8(G(c), bri), scale8(B(c), bri), scale8(W(c), bri));
+  }
+}
+
+// each pixel keeps 255-blur_amount of itself and gets blur_amount/2 of each neighbour
+static void blurLine(uint32_t *line, unsigned len, fract8 blur_amount, uint8_t bri)
+{
+  const uint8_t keep = 255 - blur_amount;
+  const uint8_t seep = blur_amount >> 1;
+  uint32_t part[len];
+  for (unsigned j = 0; j < len; j++) part[j] = scaleRGB(line[j], seep);
+  // own share plus the left neighbour's, pixels whose color did not change were not written
+  for (unsigned j = 0; j < len; j++) {
+    uint32_t cur = addRGB(scaleRGB(line[j], keep), j ? part[j-1] : 0);
+    if (cur != (line[j] & 0x00FFFFFF)) line[j] = scaleRGB(cur, bri);
+  }
+  // the right neighbour's share is added to the written pixel
+  for (unsigned j = 1; j < len; j++) line[j-1] = scaleRGB(addRGB(line[j-1], part[j]), bri);
+}
+
 // blurRow: perform a blur on a row of a rectangular matrix
 void Segment::blurRow(uint16_t row, fract8 blur_amount) {
   if (!isActive() || blur_amount == 0) return; // not active
@@ -301,25 +413,12 @@ void Segment::blurRow(uint16_t row, fract8 blur_amount) {
   const uint_fast16_t rows = virtualHeight();
 
   if (row >= rows) return;
+  if (_renderDirty) updateRenderContext(); // segment has been changed since the last refresh
   // blur one row
-  uint8_t keep = 255 - blur_amount;
-  uint8_t seep = blur_amount >> 1;
-  CRGB carryover = CRGB::Black;
-  for (unsigned x = 0; x < cols; x++) {
-    CRGB cur = getPixelColorXY(x, row);
-    CRGB before = cur;     // remember color before blur
-    CRGB part = cur;
-    part.nscale8(seep);
-    cur.nscale8(keep);
-    cur += carryover;
-    if (x>0) {
-      CRGB prev = CRGB(getPixelColorXY(x-1, row)) + part;
-      setPixelColorXY(x-1, row, prev);
-    }
-    if (before != cur)         // optimization: only set pixel if color has changed
-      setPixelColorXY(x, row, cur);
-    carryover = part;
-  }
+  uint32_t line[cols];
+  getLineXY(row, false, line);
+  blurLine(line, cols, blur_amount, _segBri);
+  setLineXY(row, false, line);
 }
 
 // blurCol: perform a blur on a column of a rectangular matrix
@@ -329,25 +428,12 @@ void Segment::blurCol(uint16_t col, fract8 blur_amount) {
   const uint_fast16_t rows = virtualHeight();
 
   if (col >= cols) return;
+  if (_renderDirty) updateRenderContext(); // segment has been changed since the last refresh
   // blur one column
-  uint8_t keep = 255 - blur_amount;
-  uint8_t seep = blur_amount >> 1;
-  CRGB carryover = CRGB::Black;
-  for (unsigned y = 0; y < rows; y++) {
-    CRGB cur = getPixelColorXY(col, y);
-    CRGB part = cur;
-    CRGB before = cur;     // remember color before blur
-    part.nscale8(seep);
-    cur.nscale8(keep);
-    cur += carryover;
-    if (y>0) {
-      CRGB prev = CRGB(getPixelColorXY(col, y-1)) + part;
-      setPixelColorXY(col, y-1, prev);
-    }
-    if (before != cur)         // optimization: only set pixel if color has changed
-      setPixelColorXY(col, y, cur);
-    carryover = part;
-  }
+  uint32_t line[rows];
+  getLineXY(col, true, line);
+  blurLine(line, rows, blur_amount, _segBri);
+  setLineXY(col, true, line);
 }
 
 // 1D Box blur (with added weight - blur_amount: [0=no blur, 255=max blur])
@@ -358,31 +444,25 @@ void Segment::box_blur(uint16_t i, bool vertical, fract8 blur_amount) {
   const uint16_t dim1 = vertical ? rows : cols;
   const uint16_t dim2 = vertical ? cols : rows;
   if (i >= dim2) return;
+  if (_renderDirty) updateRenderContext(); // segment has been changed since the last refresh
   const float seep = blur_amount/255.f;
   const float keep = 3.f - 2.f*seep;
   // 1D box blur
-  CRGB tmp[dim1];
+  uint32_t line[dim1];
+  uint32_t tmp[dim1];
+  getLineXY(i, vertical, line);
   for (int j = 0; j < dim1; j++) {
-    uint16_t x = vertical ? i : j;
-    uint16_t y = vertical ? j : i;
-    int16_t xp = vertical ? x : x-1;  // "signed" to prevent underflow
-    int16_t yp = vertical ? y-1 : y;  // "signed" to prevent underflow
-    uint16_t xn = vertical ? x : x+1;
-    uint16_t yn = vertical ? y+1 : y;
-    CRGB curr = getPixelColorXY(x,y);
-    CRGB prev = (xp<0 || yp<0) ? CRGB::Black : getPixelColorXY(xp,yp);
-    CRGB next = ((vertical && yn>=dim1) || (!vertical && xn>=dim1)) ? CRGB::Black : getPixelColorXY(xn,yn);
+    CRGB curr = line[j];
+    CRGB prev = j > 0      ? CRGB(line[j-1]) : CRGB(CRGB::Black);
+    CRGB next = j+1 < dim1 ? CRGB(line[j+1]) : CRGB(CRGB::Black);
     uint16_t r, g, b;
     r = (curr.r*keep + (prev.r + next.r)*seep) / 3;
     g = (curr.g*keep + (prev.g + next.g)*seep) / 3;
     b = (curr.b*keep + (prev.b + next.b)*seep) / 3;
-    tmp[j] = CRGB(r,g,b);
-  }
-  for (int j = 0; j < dim1; j++) {
-    uint16_t x = vertical ? i : j;
-    uint16_t y = vertical ? j : i;
-    setPixelColorXY(x, y, tmp[j]);
+    tmp[j] = RGBW32(uint8_t(r), uint8_t(g), uint8_t(b), 0);
   }
+  scaleLine(tmp, dim1, _segBri);
+  setLineXY(i, vertical, tmp);
 }
 
 // blur1d: one-dimensional blur filter. Spreads light to 2 line neighbors.
@@ -401,24 +481,35 @@ void Segment::box_blur(uint16_t i, bool vertical, fract8 blur_amount) {
 
 void Segment::blur1d(fract8 blur_amount) {
   const uint16_t rows = virtualHeight();
+  if (!strip.isServicing()) updateRenderContext(); // segment may have been changed since last frame
   for (unsigned y = 0; y < rows; y++) blurRow(y, blur_amount);
 }
 
+// moves a line read with getLineXY() by delta pixels into newPx, pixels moving in at the end are wrapped or kept
+static void moveLine(const uint32_t *line, uint32_t *newPx, int len, int delta, bool wrap)
+{
+  if (delta > 0) {
+    for (int j = 0; j < len-delta; j++)   newPx[j] = line[j + delta];
+    for (int j = len-delta; j < len; j++) newPx[j] = line[wrap ? (j + delta) - len : j];
+  } else {
+    for (int j = -delta; j < len; j++)    newPx[j] = line[j + delta];
+    for (int j = 0; j < -delta; j++)      newPx[j] = line[wrap ? (j + delta) + len : j];
+  }
+}
+
 void Segment::moveX(int8_t delta, bool wrap) {
   if (!isActive()) return; // not active
   const uint16_t cols = virtualWidth();
   const uint16_t rows = virtualHeight();
   if (!delta || abs(delta) >= cols) return;
+  if (!strip.isServicing()) updateRenderContext(); // segment may have been changed since last frame
+  uint32_t line[cols];
   uint32_t newPxCol[cols];
   for (int y = 0; y < rows; y++) {
-    if (delta > 0) {
-      for (int x = 0; x < cols-delta; x++)    newPxCol[x] = getPixelColorXY((x + delta), y);
-      for (int x = cols-delta; x < cols; x++) newPxCol[x] = getPixelColorXY(wrap ? (x + delta) - cols : x, y);
-    } else {
-      for (int x = cols-1; x >= -delta; x--) newPxCol[x] = getPixelColorXY((x + delta), y);
-      for (int x = -delta-1; x >= 0; x--)    newPxCol[x] = getPixelColorXY(wrap ? (x + delta) + cols : x, y);
-    }
-    for (int x = 0; x < cols; x++) setPixelColorXY(x, y, newPxCol[x]);
+    getLineXY(y, false, line);
+    moveLine(line, newPxCol, cols, delta, wrap);
+    scaleLine(newPxCol, cols, _segBri);
+    setLineXY(y, false, newPxCol);
   }
 }
 
@@ -427,16 +518,14 @@ void Segment::moveY(int8_t delta, bool wrap) {
   const uint16_t cols = virtualWidth();
   const uint16_t rows = virtualHeight();
   if (!delta || abs(delta) >= rows) return;
+  if (!strip.isServicing()) updateRenderContext(); // segment may have been changed since last frame
+  uint32_t line[rows];
   uint32_t newPxCol[rows];
   for (int x = 0; x < cols; x++) {
-    if (delta > 0) {
-      for (int y = 0; y < rows-delta; y++)    newPxCol[y] = getPixelColorXY(x, (y + delta));
-      for (int y = rows-delta; y < rows; y++) newPxCol[y] = getPixelColorXY(x, wrap ? (y + delta) - rows : y);
-    } else {
-      for (int y = rows-1; y >= -delta; y--) newPxCol[y] = getPixelColorXY(x, (y + delta));
-      for (int y = -delta-1; y >= 0; y--)    newPxCol[y] = getPixelColorXY(x, wrap ? (y + delta) + rows : y);
-    }
-    for (int y = 0; y < rows; y++) setPixelColorXY(x, y, newPxCol[y]);
+    getLineXY(x, true, line);
+    moveLine(line, newPxCol, rows, delta, wrap);
+    scaleLine(newPxCol, rows, _segBri);
+    setLineXY(x, true, newPxCol);
   }
 }
 
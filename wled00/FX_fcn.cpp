@@ -78,12 +78,18 @@ uint16_t Segment::maxWidth = DEFAULT_LED_COUNT;
 uint16_t Segment::maxHeight = 1;
 
 CRGBPalette16 Segment::_currentPalette    = CRGBPalette16(CRGB::Black);
+CRGB          Segment::_paletteLUT[256];
+uint32_t      Segment::_paletteLUTValid[8] = {0};
+bool          Segment::_paletteNoBlend = false;
 CRGBPalette16 Segment::_randomPalette = CRGBPalette16(DEFAULT_COLOR);
 CRGBPalette16 Segment::_newRandomPalette = CRGBPalette16(DEFAULT_COLOR);
 unsigned long Segment::_lastPaletteChange = 0; // perhaps it should be per segment
+Segment::PaletteCacheEntry Segment::_paletteCache[WLED_PALETTE_CACHE_SIZE];
+uint16_t Segment::_paletteCacheTick = 0;
 
 #ifndef WLED_DISABLE_MODE_BLEND
 bool Segment::_modeBlend = false;
+size_t Segment::_usedBlendData = 0U;
 #endif
 
 // copy constructor
@@ -91,6 +97,7 @@ Segment::Segment(const Segment &orig) {
   //DEBUG_PRINTF("-- Copy segment constructor: %p -> %p\n", &orig, this);
   memcpy((void*)this, (void*)&orig, sizeof(Segment));
   _t = nullptr; // copied segment cannot be in transition
+  _renderDirty = true;
   name = nullptr;
   data = nullptr;
   _dataLen = 0;
@@ -217,6 +224,29 @@ CRGBPalette16 &Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
     case FX_MODE_RAILWAY    : pal =  3; break; // prim + sec
     case FX_MODE_2DSOAP     : pal = 11; break; // rainbow colors
   }
+  // color and gradient palettes are costly to build (gamma32() or PROGMEM decode) and rarely change,
+  // so the last few built are kept; random, FastLED and custom palettes are cheap copies
+  PaletteCacheEntry *cache = nullptr;
+  if ((pal >= 2 && pal <= 5) || (pal >= 13 && pal <= 245)) {
+    uint32_t c0 = 0, c1 = 0, c2 = 0;
+    bool gamma = false;
+    if (pal <= 5) { c0 = colors[0]; c1 = colors[1]; c2 = colors[2]; gamma = gammaCorrectCol; }
+    cache = &_paletteCache[0];
+    for (unsigned i = 0; i < WLED_PALETTE_CACHE_SIZE; i++) {
+      PaletteCacheEntry &e = _paletteCache[i];
+      if (e.pal == pal && e.gamma == gamma && e.colors[0] == c0 && e.colors[1] == c1 && e.colors[2] == c2) {
+        e.used = ++_paletteCacheTick;
+        targetPalette = e.palette;
+        return targetPalette;
+      }
+      if (!e.pal) { cache = &e; break; } // unused slots are only at the end
+      if (uint16_t(_paletteCacheTick - e.used) > uint16_t(_paletteCacheTick - cache->used)) cache = &e; // least recently used
+    }
+    cache->pal = pal;
+    cache->gamma = gamma;
+    cache->colors[0] = c0; cache->colors[1] = c1; cache->colors[2] = c2;
+    cache->used = ++_paletteCacheTick;
+  }
   switch (pal) {
     case 0: //default palette. Exceptions for specific effects above
       targetPalette = PartyColors_p; break;
@@ -280,9 +310,15 @@ CRGBPalette16 &Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
       }
       break;
   }
+  if (cache) cache->palette = targetPalette;
   return targetPalette;
 }
 
+// forget all cached palettes, needed when something they are built from changes other than palette ID and colors (i.e. gamma table)
+void Segment::invalidatePaletteCache() {
+  for (unsigned i = 0; i < WLED_PALETTE_CACHE_SIZE; i++) _paletteCache[i].pal = 0;
+}
+
 void Segment::startTransition(uint16_t dur) {
   if (dur == 0) {
     if (isInTransition()) _t->_dur = dur; // this will stop transition in next handleTransition()
@@ -293,6 +329,7 @@ void Segment::startTransition(uint16_t dur) {
   // starting a transition has to occur before change so we get current values 1st
   _t = new Transition(dur); // no previous transition running
   if (!_t) return; // failed to allocate data
+  _renderDirty = true;
 
   //DEBUG_PRINTF("-- Started transition: %p\n", this);
   loadPalette(_t->_palT, palette);
@@ -324,6 +361,7 @@ void Segment::stopTransition() {
   //DEBUG_PRINTF("-- Stopping transition: %p\n", this);
   if (isInTransition()) {
     #ifndef WLED_DISABLE_MODE_BLEND
+    deallocateBlendBuffers();
     if (_t->_segT._dataT && _t->_segT._dataLenT > 0) {
       //DEBUG_PRINTF("--  Released duplicate data (%d): %p\n", _t->_segT._dataLenT, _t->_segT._dataT);
       free(_t->_segT._dataT);
@@ -333,6 +371,7 @@ void Segment::stopTransition() {
     #endif
     delete _t;
     _t = nullptr;
+    _renderDirty = true;
   }
 }
 
@@ -391,6 +430,60 @@ void Segment::swapSegenv(tmpsegd_t &tmpSeg) {
   //DEBUG_PRINTF("--   temp seg data: %p (%d,%p)\n", this, _dataLen, data);
 }
 
+// allocates (or reuses) one pixel buffer per mode, both starting with the current content of the segment
+bool Segment::allocateBlendBuffers() {
+  if (!isInTransition()) return false;
+  uint16_t len = length();
+  if (_t->_pixOld && _t->_pixLen == len) return true;
+  deallocateBlendBuffers(); // segment was resized
+  size_t size = 2 * len * sizeof(uint32_t);
+  if (!len || _usedBlendData + size > MAX_BLEND_DATA) return false;
+  #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+  if (psramFound()) _t->_pixOld = (uint32_t*) ps_malloc(size); else
+  #endif
+  _t->_pixOld = (uint32_t*) malloc(size);
+  if (!_t->_pixOld) {
+    DEBUG_PRINTLN(F("!!! Not enough RAM for blend buffers !!!"));
+    return false;
+  }
+  _t->_pixNew = _t->_pixOld + len;
+  _t->_pixLen = len;
+  _usedBlendData += size;
+  copyBlendBuffer(true, false);
+  memcpy(_t->_pixNew, _t->_pixOld, len * sizeof(uint32_t));
+  return true;
+}
+
+void Segment::deallocateBlendBuffers() {
+  if (!_t || !_t->_pixOld) return;
+  free(_t->_pixOld);
+  _usedBlendData -= 2 * _t->_pixLen * sizeof(uint32_t);
+  _t->_pixOld = _t->_pixNew = nullptr;
+  _t->_pixLen = 0;
+}
+
+void Segment::copyBlendBuffer(bool prev, bool toStrip) {
+  uint32_t *buf = prev ? _t->_pixOld : _t->_pixNew;
+  for (unsigned y = startY; y < stopY; y++) {
+    for (unsigned x = start; x < stop; x++) {
+      uint16_t i = x + y * Segment::maxWidth; // same index as WS2812FX::setPixelColorXY(), y is 0 for 1D segments
+      if (toStrip) strip.setPixelColor(i, *buf++);
+      else         *buf++ = strip.getPixelColor(i);
+    }
+  }
+}
+
+void Segment::compositeBlendBuffers() {
+  uint16_t prog = progress();
+  const uint32_t *pOld = _t->_pixOld;
+  const uint32_t *pNew = _t->_pixNew;
+  for (unsigned y = startY; y < stopY; y++) {
+    for (unsigned x = start; x < stop; x++) {
+      strip.setPixelColor(x + y * Segment::maxWidth, color_blend(*pOld++, *pNew++, prog, true));
+    }
+  }
+}
+
 void Segment::restoreSegenv(tmpsegd_t &tmpSeg) {
   //DEBUG_PRINTF("--  Restoring temp seg: %p (%p)\n", this, tmpSeg);
   if (_t && &(_t->_segT) != &tmpSeg) {
@@ -460,6 +553,9 @@ void Segment::setCurrentPalette() {
     for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, _currentPalette, 48);
     _currentPalette = _t->_palT; // copy transitioning/temporary palette
   }
+  // LUT entries are expanded from the new palette on first use
+  memset(_paletteLUTValid, 0, sizeof(_paletteLUTValid));
+  _paletteNoBlend = strip.paletteBlend == 3;
 }
 
 // relies on WS2812FX::service() to call it max every 8ms or more (MIN_SHOW_DELAY)
@@ -483,6 +579,7 @@ void Segment::setUp(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, uint16_t
   stateChanged = true; // send UDP/WS broadcast
 
   if (stop) fill(BLACK); // turn old segment range off (clears pixels if changing spacing)
+  _renderDirty = true;
   if (grp) { // prevent assignment of 0
     grouping = grp;
     spacing = spc;
@@ -551,6 +648,7 @@ void Segment::setOpacity(uint8_t o) {
   if (opacity == o) return;
   if (fadeTransition) startTransition(strip.getTransition()); // start transition prior to change
   opacity = o;
+  _renderDirty = true;
   stateChanged = true; // send UDP/WS broadcast
 }
 
@@ -559,6 +657,7 @@ void Segment::setOption(uint8_t n, bool val) {
   if (fadeTransition && n == SEG_OPTION_ON && val != prevOn) startTransition(strip.getTransition()); // start transition prior to change
   if (val) options |=   0x01 << n;
   else     options &= ~(0x01 << n);
+  _renderDirty = true;
   if (!(n == SEG_OPTION_SELECTED || n == SEG_OPTION_RESET)) stateChanged = true; // send UDP/WS broadcast
 }
 
@@ -590,6 +689,7 @@ void Segment::setMode(uint8_t fx, bool loadDefaults) {
         sOpt = extractModeDefaults(fx, "pal");  if (sOpt >= 0) setPalette(sOpt); //else setPalette(0);
       }
       markForReset();
+      _renderDirty = true;
       stateChanged = true; // send UDP/WS broadcast
     }
   }
@@ -659,15 +759,64 @@ uint16_t Segment::virtualLength() const {
   return vLength;
 }
 
+// caches what setPixelColor()/getPixelColor() would otherwise compute for every pixel:
+// 1D geometry, brightness/opacity and mode blending progress (called for each segment once per frame)
+void Segment::updateRenderContext() {
+  _vLength = virtualLength();
+  uint16_t len = length();
+  _pxFirst = start;
+  if (reverse) _pxFirst += mirror ? (len - 1) / 2 : len - 1;
+  _segBri = currentBri();
+  _blendT = 0xFFFFU - progress();
+  // (i*255)/(_vLength-1) == (i*_palScale)>>24 holds for all i < _vLength as long as (_vLength-1)^2 < 2^24
+  _palScale = _vLength > 1 && _vLength <= 4096 ? (0xFF000000U + _vLength - 2) / (_vLength - 1) : 0;
+  selectPixelWriters();
+  _renderDirty = false;
+}
+
+// Picks the writers setPixelColor()/setPixelColorXY() use for the current options.
+// Mode blending is part of the choice, it is only set around the old mode's run which refreshes the render context.
+void Segment::selectPixelWriters() {
+  bool plain = !mirror;
+#ifndef WLED_DISABLE_MODE_BLEND
+  plain &= !_modeBlend;
+#endif
+  _pixelWriter = nullptr;
+#ifndef WLED_DISABLE_2D
+  _pixelWriterXY = nullptr;
+  if (is2D()) {
+    if (plain && !mirror_y && !reverse && !reverse_y && !transpose)
+      _pixelWriterXY = (grouping == 1 && spacing == 0) ? &setPixel2D<false> : &setPixel2D<true>;
+    return;
+  }
+  if (Segment::maxHeight != 1 && (width() == 1 || height() == 1) && start < Segment::maxWidth*Segment::maxHeight) return; // 1D segment in matrix
+#endif
+  if (plain && grouping == 1 && spacing == 0) _pixelWriter = reverse ? &setPixel1D<true> : &setPixel1D<false>;
+}
+
+// 1D segment without grouping, spacing or mirroring: virtual pixel i is the physical pixel _pxFirst+i (-i if reversed) rotated by offset
+template<bool REVERSED> void IRAM_ATTR Segment::setPixel1D(Segment &seg, int i, uint32_t col)
+{
+  i &= 0xFFFF;
+  if (i >= seg._vLength) return; // if pixel would fall out of segment just exit
+  if (seg._segBri < 255) col = color_fade(col, seg._segBri);
+  uint16_t indexSet = REVERSED ? seg._pxFirst - i : seg._pxFirst + i;
+  indexSet += seg.offset; // offset/phase
+  if (indexSet >= seg.stop) indexSet -= seg.length(); // wrap
+  strip.setPixelColor(indexSet, col);
+}
+
 void IRAM_ATTR Segment::setPixelColor(int i, uint32_t col)
 {
   if (!isActive()) return; // not active
+  if (_renderDirty) updateRenderContext(); // segment has been changed since the last refresh
+  if (_pixelWriter) { _pixelWriter(*this, i, col); return; }
 #ifndef WLED_DISABLE_2D
   int vStrip = i>>16; // hack to allow running on virtual strips (2D segment columns/rows)
 #endif
   i &= 0xFFFF;
 
-  if (i >= virtualLength() || i<0) return;  // if pixel would fall out of segment just exit
+  if (i >= _vLength || i<0) return;  // if pixel would fall out of segment just exit
 
 #ifndef WLED_DISABLE_2D
   if (is2D()) {
@@ -730,7 +879,7 @@ void IRAM_ATTR Segment::setPixelColor(int i, uint32_t col)
 #endif
 
   uint16_t len = length();
-  uint8_t _bri_t = currentBri();
+  uint8_t _bri_t = _segBri;
   if (_bri_t < 255) {
     byte r = scale8(R(col), _bri_t);
     byte g = scale8(G(col), _bri_t);
@@ -740,15 +889,8 @@ void IRAM_ATTR Segment::setPixelColor(int i, uint32_t col)
   }
 
   // expand pixel (taking into account start, grouping, spacing [and offset])
-  i = i * groupLength();
-  if (reverse) { // is segment reversed?
-    if (mirror) { // is segment mirrored?
-      i = (len - 1) / 2 - i;  //only need to index half the pixels
-    } else {
-      i = (len - 1) - i;
-    }
-  }
-  i += start; // starting pixel in a group
+  if (reverse) i = _pxFirst - i * groupLength(); // reversed (and mirrored) start is precomputed
+  else         i = _pxFirst + i * groupLength(); // starting pixel in a group
 
   uint32_t tmpCol = col;
   // set all the pixels in the group
@@ -760,14 +902,14 @@ void IRAM_ATTR Segment::setPixelColor(int i, uint32_t col)
         indexMir += offset; // offset/phase
         if (indexMir >= stop) indexMir -= len; // wrap
 #ifndef WLED_DISABLE_MODE_BLEND
-        if (_modeBlend) tmpCol = color_blend(strip.getPixelColor(indexMir), col, 0xFFFFU - progress(), true);
+        if (_modeBlend) tmpCol = color_blend(strip.getPixelColor(indexMir), col, _blendT, true);
 #endif
         strip.setPixelColor(indexMir, tmpCol);
       }
       indexSet += offset; // offset/phase
       if (indexSet >= stop) indexSet -= len; // wrap
 #ifndef WLED_DISABLE_MODE_BLEND
-      if (_modeBlend) tmpCol = color_blend(strip.getPixelColor(indexSet), col, 0xFFFFU - progress(), true);
+      if (_modeBlend) tmpCol = color_blend(strip.getPixelColor(indexSet), col, _blendT, true);
 #endif
       strip.setPixelColor(indexSet, tmpCol);
     }
@@ -810,6 +952,7 @@ void Segment::setPixelColor(float i, uint32_t col, bool aa)
 uint32_t Segment::getPixelColor(int i)
 {
   if (!isActive()) return 0; // not active
+  if (_renderDirty) updateRenderContext(); // segment has been changed since the last refresh
 #ifndef WLED_DISABLE_2D
   int vStrip = i>>16;
 #endif
@@ -837,7 +980,7 @@ uint32_t Segment::getPixelColor(int i)
   }
 #endif
 
-  if (reverse) i = virtualLength() - i - 1;
+  if (reverse) i = _vLength - i - 1;
   i *= groupLength();
   i += start;
   /* offset/phase */
@@ -928,6 +1071,7 @@ void Segment::refreshLightCapabilities() {
  */
 void Segment::fill(uint32_t c) {
   if (!isActive()) return; // not active
+  if (!strip.isServicing()) updateRenderContext(); // segment may have been changed since last frame
   const uint16_t cols = is2D() ? virtualWidth() : virtualLength();
   const uint16_t rows = virtualHeight(); // will be 1 for 1D
   for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
@@ -952,52 +1096,84 @@ void Segment::fadePixelColor(uint16_t n, uint8_t fade) {
   setPixelColor(n, color_fade(getPixelColor(n), fade, true));
 }
 
+// color setPixelColor()/setPixelColorXY() store when writing c over a pixel holding old (brightness and mode blending applied)
+uint32_t Segment::writtenColor(uint32_t old, uint32_t c) const {
+  if (_segBri < 255) c = color_fade(c, _segBri);
+#ifndef WLED_DISABLE_MODE_BLEND
+  if (_modeBlend) c = color_blend(old, c, _blendT, true);
+#endif
+  return c;
+}
+
+// Calls fn(old color) for each physical pixel of a segment and stores what it returns.
+// Only for segments where each physical pixel is a virtual pixel of its own (no grouping, spacing or mirroring):
+// each pixel is then read and written once whatever its virtual position, so rows of the frame buffer
+// can be processed in place instead of going through getPixelColor()/setPixelColor() per pixel.
+template<typename F> static void mapSegmentPixels(const Segment &seg, F fn)
+{
+  const unsigned len = seg.stop - seg.start;
+  for (unsigned y = seg.startY; y < seg.stopY; y++) {
+    const unsigned idx = y * Segment::maxWidth + seg.start;
+    uint32_t *px = strip.getPixelSpan(idx, len);
+    if (px) {
+      for (unsigned i = 0; i < len; i++) px[i] = fn(px[i]);
+      strip.commitPixelSpan(idx, len);
+    } else {
+      for (unsigned i = 0; i < len; i++) strip.setPixelColor(idx + i, fn(strip.getPixelColor(idx + i)));
+    }
+  }
+}
+
 /*
  * fade out function, higher rate = quicker fade
  */
 void Segment::fade_out(uint8_t rate) {
   if (!isActive()) return; // not active
+  if (!strip.isServicing()) updateRenderContext(); // segment may have been changed since last frame
   const uint16_t cols = is2D() ? virtualWidth() : virtualLength();
   const uint16_t rows = virtualHeight(); // will be 1 for 1D
 
   rate = (255-rate) >> 1;
-  float mappedRate = float(rate) +1.1f;
-
-  uint32_t color = colors[1]; // SEGCOLOR(1); // target color
-  int w2 = W(color);
-  int r2 = R(color);
-  int g2 = G(color);
-  int b2 = B(color);
-
+  // delta/(rate+1.1) in 14.18 fixed point, rounded up so exact quotients are not truncated
+  const uint32_t recip = ((10UL << 18) + 10*rate + 10) / (10*rate + 11);
+
+  const uint32_t color = colors[1]; // SEGCOLOR(1); // target color
+  const int w2 = W(color);
+  const int r2 = R(color);
+  const int g2 = G(color);
+  const int b2 = B(color);
+
+  // move each channel towards the target by delta/mappedRate, at least 1 (fixes rounding issues)
+  auto step = [recip](int c1, int c2) {
+    if (c2 > c1) return c1 + int((uint32_t(c2 - c1) * recip) >> 18) + 1;
+    if (c2 < c1) return c1 - int((uint32_t(c1 - c2) * recip) >> 18) - 1;
+    return c1;
+  };
+  auto fade = [&](uint32_t c) {
+    return RGBW32(step(R(c), r2), step(G(c), g2), step(B(c), b2), step(W(c), w2));
+  };
+
+  if (grouping == 1 && spacing == 0 && !mirror && !mirror_y) {
+    mapSegmentPixels(*this, [&](uint32_t c) { return writtenColor(c, fade(c)); });
+    return;
+  }
   for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
-    color = is2D() ? getPixelColorXY(x, y) : getPixelColor(x);
-    int w1 = W(color);
-    int r1 = R(color);
-    int g1 = G(color);
-    int b1 = B(color);
-
-    int wdelta = (w2 - w1) / mappedRate;
-    int rdelta = (r2 - r1) / mappedRate;
-    int gdelta = (g2 - g1) / mappedRate;
-    int bdelta = (b2 - b1) / mappedRate;
-
-    // if fade isn't complete, make sure delta is at least 1 (fixes rounding issues)
-    wdelta += (w2 == w1) ? 0 : (w2 > w1) ? 1 : -1;
-    rdelta += (r2 == r1) ? 0 : (r2 > r1) ? 1 : -1;
-    gdelta += (g2 == g1) ? 0 : (g2 > g1) ? 1 : -1;
-    bdelta += (b2 == b1) ? 0 : (b2 > b1) ? 1 : -1;
-
-    if (is2D()) setPixelColorXY(x, y, r1 + rdelta, g1 + gdelta, b1 + bdelta, w1 + wdelta);
-    else        setPixelColor(x, r1 + rdelta, g1 + gdelta, b1 + bdelta, w1 + wdelta);
+    if (is2D()) setPixelColorXY(x, y, fade(getPixelColorXY(x, y)));
+    else        setPixelColor(x, fade(getPixelColor(x)));
   }
 }
 
 // fades all pixels to black using nscale8()
 void Segment::fadeToBlackBy(uint8_t fadeBy) {
   if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
+  if (!strip.isServicing()) updateRenderContext(); // segment may have been changed since last frame
   const uint16_t cols = is2D() ? virtualWidth() : virtualLength();
   const uint16_t rows = virtualHeight(); // will be 1 for 1D
 
+  if (grouping == 1 && spacing == 0 && !mirror && !mirror_y) {
+    mapSegmentPixels(*this, [this, fadeBy](uint32_t c) { return writtenColor(c, color_fade(c, 255-fadeBy)); });
+    return;
+  }
   for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
     if (is2D()) setPixelColorXY(x, y, color_fade(getPixelColorXY(x,y), 255-fadeBy));
     else        setPixelColor(x, color_fade(getPixelColor(x), 255-fadeBy));
@@ -1010,6 +1186,7 @@ void Segment::fadeToBlackBy(uint8_t fadeBy) {
 void Segment::blur(uint8_t blur_amount)
 {
   if (!isActive() || blur_amount == 0) return; // optimization: 0 means "don't blur"
+  if (!strip.isServicing()) updateRenderContext(); // segment may have been changed since last frame
 #ifndef WLED_DISABLE_2D
   if (is2D()) {
     // compatibility with 2D
@@ -1075,12 +1252,58 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool wrap, uint8_
     return color_fade(color, pbri, true);
   }
 
+  if (mapping && _renderDirty) updateRenderContext(); // segment has been changed since the last refresh
+  return paletteColor(paletteIndex(i, mapping, wrap), pbri);
+}
+
+/*
+ * Fills a span of the segment with palette colors mapped onto its length.
+ * Same result as calling setPixelColor(i, color_from_palette(i, true, wrap, mcol, pbri)) for every pixel
+ * but the per-pixel checks are only done once.
+ */
+void Segment::fillPalette(uint16_t first, uint16_t count, bool wrap, uint8_t mcol, uint8_t pbri)
+{
+  if (!isActive()) return;
+  if (!strip.isServicing()) updateRenderContext(); // segment may have been changed since last frame
+  unsigned end = MIN(unsigned(first) + count, unsigned(_vLength));
+  if ((palette == 0 && mcol < NUM_COLORS) || !_isRGB) {
+    uint32_t color = color_from_palette(0, false, wrap, mcol, pbri);
+    for (unsigned i = first; i < end; i++) setPixelColor(int(i), color);
+    return;
+  }
+  for (unsigned i = first; i < end; i++) setPixelColor(int(i), paletteColor(paletteIndex(i, true, wrap), pbri));
+}
+
+// palette index of pixel i, with the "end" of the palette cut off unless wrapping (or not blending)
+uint8_t Segment::paletteIndex(uint16_t i, bool mapping, bool wrap) const
+{
   uint8_t paletteIndex = i;
-  if (mapping && virtualLength() > 1) paletteIndex = (i*255)/(virtualLength() -1);
-  if (!wrap && strip.paletteBlend != 3) paletteIndex = scale8(paletteIndex, 240); //cut off blend at palette "end"
-  CRGB fastled_col = ColorFromPalette(_currentPalette, paletteIndex, pbri, (strip.paletteBlend == 3)? NOBLEND:LINEARBLEND); // NOTE: paletteBlend should be global
+  if (mapping && _vLength > 1) {
+    if (i < _vLength && _palScale) paletteIndex = (uint64_t(i) * _palScale) >> 24;
+    else                           paletteIndex = (i*255)/(_vLength -1);
+  }
+  if (!wrap && !_paletteNoBlend) paletteIndex = scale8(paletteIndex, 240); //cut off blend at palette "end"
+  return paletteIndex;
+}
 
-  return RGBW32(fastled_col.r, fastled_col.g, fastled_col.b, 0);
+// color at index of the current palette scaled by pbri, identical to ColorFromPalette(_currentPalette, index, pbri, blend)
+uint32_t Segment::paletteColor(uint8_t index, uint8_t pbri)
+{
+  uint32_t &valid = _paletteLUTValid[index >> 5];
+  uint32_t  bit   = 1U << (index & 0x1F);
+  if (!(valid & bit)) {
+    _paletteLUT[index] = ColorFromPalette(_currentPalette, index, 255, _paletteNoBlend ? NOBLEND : LINEARBLEND);
+    valid |= bit;
+  }
+  CRGB c = _paletteLUT[index];
+  if (pbri == 0) return BLACK;
+  if (pbri != 255) {
+    pbri++; // FastLED adjusts brightness for rounding
+    c.r = scale8(c.r, pbri);
+    c.g = scale8(c.g, pbri);
+    c.b = scale8(c.b, pbri);
+  }
+  return RGBW32(c.r, c.g, c.b, 0);
 }
 
 
@@ -1088,6 +1311,14 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool wrap, uint8_
 // WS2812FX class implementation
 ///////////////////////////////////////////////////////////////////////////////
 
+// frame buffer (_pixels) goes to PSRAM if it is available, see finalizeInit()
+uint32_t WS2812FX::frameBufferMem(uint16_t len) {
+  #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+  if (psramFound()) return 0;
+  #endif
+  return len * sizeof(uint32_t);
+}
+
 //do not call this method from system context (network callback)
 void WS2812FX::finalizeInit(void)
 {
@@ -1102,7 +1333,7 @@ void WS2812FX::finalizeInit(void)
   // unfortunately this means we do not get updates after uploads
   enumerateLedmaps();
 
-  _hasWhiteChannel = _isOffRefreshRequired = false;
+  _hasWhiteChannel = _isOffRefreshRequired = _hasCCTBus = false;
 
   //if busses failed to load, add default (fresh install, FS issue, ...)
   if (busses.getNumBusses() == 0) {
@@ -1131,6 +1362,7 @@ void WS2812FX::finalizeInit(void)
     _hasWhiteChannel |= bus->hasWhite();
     //refresh is required to remain off if at least one of the strips requires the refresh.
     _isOffRefreshRequired |= bus->isOffRefreshRequired();
+    _hasCCTBus |= bus->hasCCT();
     uint16_t busEnd = bus->getStart() + bus->getLength();
     if (busEnd > _length) _length = busEnd;
     #ifdef ESP8266
@@ -1142,6 +1374,29 @@ void WS2812FX::finalizeInit(void)
     #endif
   }
 
+  // (re)allocate frame buffer (memory for it is accounted for when busses are created, see cfg.cpp)
+  if (_pixels) free(_pixels);
+  _pixels = nullptr;
+  if (useGlobalLedBuffer && _length) {
+    #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+    if (psramFound()) _pixels = (uint32_t*)ps_calloc(_length, sizeof(uint32_t)); else
+    #endif
+    _pixels = (uint32_t*)calloc(_length, sizeof(uint32_t));
+    if (!_pixels) DEBUG_PRINTLN(F("!!! Not enough RAM for frame buffer !!!")); // busses will be written directly
+  }
+  // reallocated for the new length by updateRealtimeSegments()
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestLock(); // realtime input may be received by other tasks
+  #endif
+  uint32_t *realtimeInput = _realtimeInput;
+  _hasRealtimeSegments = false; // stop writers before the buffer is freed
+  _realtimeInput = nullptr;
+  _realtimeInputLen = 0;
+  free(realtimeInput);
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestUnlock();
+  #endif
+
   if (isMatrix) setUpMatrix();
   else {
     Segment::maxWidth  = _length;
@@ -1159,63 +1414,117 @@ void WS2812FX::service() {
   unsigned long nowUp = millis(); // Be aware, millis() rolls over every 49 days
   now = nowUp + timebase;
   if (nowUp - _lastShow < MIN_SHOW_DELAY) return;
+
+  // lockstep: nodes render the frames of a clock derived from toki (NTP), each exactly once, catching up on a
+  // few missed ones, with time (strip.now) and random numbers computed from the frame number, so that
+  // deterministic effects have the same state on all nodes
+  bool lockstepActive = lockstep && toki.getTimeSource() >= TOKI_TS_UDP_NTP;
+  if (lockstepActive != _lockstepActive) {
+    _lockstepActive = lockstepActive;
+    _lockstepFrame = 0;
+    for (segment &seg : _segments) seg.next_time = 0; // time base changes
+  }
+  uint32_t frame = 0, frames = 1;
+  if (_lockstepActive) {
+    Toki::Time t = toki.getTime();
+    frame = ((uint64_t)t.sec * 1000 + t.ms) / _frametime;
+    if (frame == _lockstepFrame) return;
+    frames = frame - _lockstepFrame;
+    if (frames > LOCKSTEP_MAX_CATCHUP) frames = 1; // too far behind (or starting), the next resync restores the state
+    _lockstepFrame = frame;
+    frame -= frames;
+  }
   bool doShow = false;
 
   _isServicing = true;
-  _segment_index = 0;
+  // busses apply segment CCT (white balance or CCT channels) when a pixel is written,
+  // so it cannot be deferred to the frame buffer flush in show()
+  _directBusWrite = correctWB || (_hasCCTBus && !cctFromRgb);
   Segment::handleRandomPalette(); // move it into for loop when each segment has individual random palette
-  for (segment &seg : _segments) {
-    // process transition (mode changes in the middle of transition)
-    seg.handleTransition();
-    // reset the segment runtime data if needed
-    seg.resetIfRequired();
-
-    if (!seg.isActive()) continue;
-
-    // last condition ensures all solid segments are updated at the same time
-    if (nowUp > seg.next_time || _triggered || (doShow && seg.mode == FX_MODE_STATIC))
-    {
-      doShow = true;
-      uint16_t delay = FRAMETIME;
-
-      if (!seg.freeze) { //only run effect function if not frozen
-        _virtualSegmentLength = seg.virtualLength();
-        _colors_t[0] = seg.currentColor(0);
-        _colors_t[1] = seg.currentColor(1);
-        _colors_t[2] = seg.currentColor(2);
-        seg.setCurrentPalette();              // load actual palette
-
-        if (!cctFromRgb || correctWB) busses.setSegmentCCT(seg.currentBri(true), correctWB);
-        for (int c = 0; c < NUM_COLORS; c++) _colors_t[c] = gamma32(_colors_t[c]);
-
-        // Effect blending
-        // When two effects are being blended, each may have different segment data, this
-        // data needs to be saved first and then restored before running previous mode.
-        // The blending will largely depend on the effect behaviour since actual output (LEDs) may be
-        // overwritten by later effect. To enable seamless blending for every effect, additional LED buffer
-        // would need to be allocated for each effect and then blended together for each pixel.
-        [[maybe_unused]] uint8_t tmpMode = seg.currentMode();  // this will return old mode while in transition
-        delay = (*_mode[seg.mode])();         // run new/current mode
+  while (frames--) {
+    unsigned long frameUp = nowUp;
+    if (_lockstepActive) {
+      frame++;
+      frameUp = now = frame * _frametime;
+    }
+    _segment_index = 0;
+    for (segment &seg : _segments) {
+      // process transition (mode changes in the middle of transition)
+      seg.handleTransition();
+      // reset the segment runtime data if needed
+      if (_lockstepActive && frame == _lockstepResetFrame) seg.markForReset(); // all nodes restart their effects at this frame
+      seg.resetIfRequired();
+
+      if (!seg.isActive()) continue;
+
+      // last condition ensures all solid segments are updated at the same time
+      // in lockstep segments are updated on frames only, triggering at other times would make nodes diverge
+      bool due = _lockstepActive ? (long)(frameUp - seg.next_time) >= 0 : (nowUp > seg.next_time || _triggered);
+      if (due || (doShow && seg.mode == FX_MODE_STATIC))
+      {
+        doShow = true;
+        uint16_t delay = FRAMETIME;
+
+        if (!seg.freeze) { //only run effect function if not frozen
+          seg.updateRenderContext();           // geometry, brightness and transition progress for this frame
+          _virtualSegmentLength = seg.virtualLength();
+          _colors_t[0] = seg.currentColor(0);
+          _colors_t[1] = seg.currentColor(1);
+          _colors_t[2] = seg.currentColor(2);
+          seg.setCurrentPalette();              // load actual palette
+
+          if (!cctFromRgb || correctWB) busses.setSegmentCCT(seg.currentBri(true), correctWB);
+          for (int c = 0; c < NUM_COLORS; c++) _colors_t[c] = gamma32(_colors_t[c]);
+
+          // Effect blending
+          // When two effects are being blended, each may have different segment data, this
+          // data needs to be saved first and then restored before running previous mode.
+          // The blending will largely depend on the effect behaviour since actual output (LEDs) may be
+          // overwritten by later effect. To enable seamless blending for every effect, additional LED buffer
+          // would need to be allocated for each effect and then blended together for each pixel.
+          // If memory allows, each mode renders into its own buffer instead (see MAX_BLEND_DATA) and the
+          // buffers are cross-faded once both modes are done.
+          [[maybe_unused]] uint8_t tmpMode = seg.currentMode();  // this will return old mode while in transition
 #ifndef WLED_DISABLE_MODE_BLEND
-        if (modeBlending && seg.mode != tmpMode) {
-          Segment::tmpsegd_t _tmpSegData;
-          Segment::modeBlend(true);           // set semaphore
-          seg.swapSegenv(_tmpSegData);        // temporarily store new mode state (and swap it with transitional state)
-          _virtualSegmentLength = seg.virtualLength(); // update SEGLEN (mapping may have changed)
-          uint16_t d2 = (*_mode[tmpMode])();  // run old mode
-          seg.restoreSegenv(_tmpSegData);     // restore mode state (will also update transitional state)
-          delay = MIN(delay,d2);              // use shortest delay
-          Segment::modeBlend(false);          // unset semaphore
-        }
+          bool blendBuffered = modeBlending && seg.mode != tmpMode && seg.allocateBlendBuffers();
+          if (blendBuffered) seg.copyBlendBuffer(false, true); // new mode continues from its own last frame
 #endif
-        if (seg.mode != FX_MODE_HALLOWEEN_EYES) seg.call++;
-        if (seg.isInTransition() && delay > FRAMETIME) delay = FRAMETIME; // force faster updates during transition
-      }
+          if (_lockstepActive) random16_set_seed(((frame << 5) + _segment_index) * 2654435761U >> 16 ^ lockstepSeed); // same random numbers on all nodes
+          delay = (*_mode[seg.mode])();         // run new/current mode
+#ifndef WLED_DISABLE_MODE_BLEND
+          if (modeBlending && seg.mode != tmpMode) {
+            Segment::tmpsegd_t _tmpSegData;
+            if (blendBuffered) {
+              seg.copyBlendBuffer(false, false);
+              seg.copyBlendBuffer(true, true);  // old mode continues from its own last frame
+            } else {
+              Segment::modeBlend(true);         // set semaphore
+            }
+            seg.swapSegenv(_tmpSegData);        // temporarily store new mode state (and swap it with transitional state)
+            seg.updateRenderContext();          // options (on/reverse/mirror) may differ
+            _virtualSegmentLength = seg.virtualLength(); // update SEGLEN (mapping may have changed)
+            uint16_t d2 = (*_mode[tmpMode])();  // run old mode
+            seg.restoreSegenv(_tmpSegData);     // restore mode state (will also update transitional state)
+            seg.updateRenderContext();
+            delay = MIN(delay,d2);              // use shortest delay
+            if (blendBuffered) {
+              seg.copyBlendBuffer(true, false);
+              seg.compositeBlendBuffers();
+            } else {
+              Segment::modeBlend(false);        // unset semaphore
+            }
+          }
+#endif
+          if (seg.mode != FX_MODE_HALLOWEEN_EYES) seg.call++;
+          if (seg.isInTransition() && delay > FRAMETIME) delay = FRAMETIME; // force faster updates during transition
+        }
 
-      seg.next_time = nowUp + delay;
+        seg.next_time = frameUp + delay;
+      }
+      if (_segment_index == _queuedChangesSegId) setUpSegmentFromQueuedChanges();
+      _segment_index++;
     }
-    if (_segment_index == _queuedChangesSegId) setUpSegmentFromQueuedChanges();
-    _segment_index++;
+    if (_lockstepActive && frame % LOCKSTEP_CHECK_FRAMES == 0) lockstepCheckpoint(frame, 0); // our own checkpoint
   }
   _virtualSegmentLength = 0;
   busses.setSegmentCCT(-1);
@@ -1234,20 +1543,131 @@ void WS2812FX::service() {
   #endif
 }
 
+// restart all effects at the given shared frame (ignored unless it is ahead of us)
+// if several nodes request a resync, all of them keep the earliest frame so they restart together
+void WS2812FX::lockstepResync(uint32_t frame) {
+  if ((int32_t)(frame - _lockstepFrame) <= 0) return;
+  bool pending = _lockstepResetFrame && (int32_t)(_lockstepResetFrame - _lockstepFrame) > 0;
+  if (!pending || (int32_t)(frame - _lockstepResetFrame) < 0) _lockstepResetFrame = frame;
+}
+
+// compares effect state checkpoints: hash 0 records our own checkpoint after rendering the frame,
+// otherwise it is the checkpoint of another node, which we may not have reached yet
+void WS2812FX::lockstepCheckpoint(uint32_t frame, uint32_t hash) {
+  if (hash == 0) {
+    uint32_t h = 2166136261U; // FNV-1a over the runtime state of all active segments
+    for (segment &seg : _segments) {
+      if (!seg.isActive()) continue;
+      uint32_t state[5] = {seg.mode, seg.call, seg.step, seg.aux0, seg.aux1};
+      for (size_t i = 0; i < sizeof(state); i++) h = (h ^ ((uint8_t*)state)[i]) * 16777619U;
+      for (size_t i = 0; seg.data && i < seg.dataSize(); i++) h = (h ^ seg.data[i]) * 16777619U;
+    }
+    _lockstepCheckFrame = frame;
+    _lockstepCheckHash  = h | 1; // never 0
+    if (_lockstepRemoteFrame == frame && _lockstepRemoteHash != _lockstepCheckHash) _lockstepDiverged = true;
+  } else if (frame == _lockstepCheckFrame) {
+    if (hash != _lockstepCheckHash) _lockstepDiverged = true;
+  } else if ((int32_t)(frame - _lockstepCheckFrame) > 0) {
+    _lockstepRemoteFrame = frame;
+    _lockstepRemoteHash  = hash;
+  }
+}
+
+// realtime input goes to the segments running the "Realtime" effect while there are any, the other segments
+// keep running their effects; called from the main loop, as realtime input to the whole strip stops service()
+// inputLen - realtime pixels the configured input carries (see realtimeInputLength())
+void WS2812FX::updateRealtimeSegments(uint16_t inputLen) {
+  bool found = false;
+  for (segment &seg : _segments) if (seg.isActive() && seg.mode == FX_MODE_REALTIME) { found = true; break; }
+  if (_realtimeInput ? (found && inputLen == _realtimeInputLen) : !found) return; // nothing to (re)allocate
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestLock(); // realtime input may be received by other tasks
+  #endif
+  uint32_t *realtimeInput = _realtimeInput;
+  _hasRealtimeSegments = false; // stop writers before the buffer is freed
+  _realtimeInput = nullptr;
+  _realtimeInputLen = 0;
+  free(realtimeInput);
+  if (found && inputLen) {
+    _realtimeInput = (uint32_t*)calloc(inputLen, sizeof(uint32_t));
+    if (_realtimeInput) _realtimeInputLen = inputLen;
+    else DEBUG_PRINTLN(F("!!! Not enough RAM for realtime input !!!"));
+  }
+  _hasRealtimeSegments = found && _realtimeInput;
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestUnlock();
+  #endif
+}
+
+void WS2812FX::setRealtimeInput(uint16_t i, const uint32_t *c, uint16_t count) {
+  if (!_realtimeInput || i >= _realtimeInputLen) return;
+  memcpy(_realtimeInput + i, c, MIN(count, _realtimeInputLen - i) * sizeof(uint32_t));
+}
+
+void WS2812FX::clearRealtimeInput() {
+  if (_realtimeInput) memset(_realtimeInput, 0, _realtimeInputLen * sizeof(uint32_t));
+}
+
 void IRAM_ATTR WS2812FX::setPixelColor(int i, uint32_t col)
 {
   if (i < customMappingSize) i = customMappingTable[i];
   if (i >= _length) return;
-  busses.setPixelColor(i, col);
+  if (_pixels) _pixels[i] = col;
+  if (!_pixels || _directBusWrite) busses.setPixelColor(i, col);
 }
 
+void WS2812FX::setPixels(uint16_t i, const uint32_t *c, uint16_t count)
+{
+  for (; count && i < customMappingSize; i++, c++, count--) setPixelColor(i, *c); // ledmap scatters pixels
+  if (i >= _length || !count) return;
+  if (count > _length - i) count = _length - i;
+  if (_pixels) memcpy(_pixels + i, c, count * sizeof(uint32_t));
+  if (!_pixels || _directBusWrite) busses.setPixels(i, c, count);
+}
+
+void WS2812FX::commitPixelSpan(uint16_t i, uint16_t count)
+{
+  if (_pixels && _directBusWrite) busses.setPixels(i, _pixels + i, count); // buffer is not flushed in show()
+}
+
+void WS2812FX::fill(uint32_t c)
+{
+  if (customMappingSize) { // ledmap may leave some physical pixels unmapped
+    for (int i = 0; i < getLengthTotal(); i++) setPixelColor(i, c);
+    return;
+  }
+  if (_pixels) {
+    for (uint16_t i = 0; i < _length; i++) _pixels[i] = c;
+    if (_directBusWrite) busses.setPixels(0, _pixels, _length);
+    return;
+  }
+  uint32_t span[32];
+  for (size_t i = 0; i < sizeof(span)/sizeof(uint32_t); i++) span[i] = c;
+  for (uint16_t i = 0; i < _length; i += sizeof(span)/sizeof(uint32_t)) {
+    busses.setPixels(i, span, MIN(sizeof(span)/sizeof(uint32_t), (size_t)(_length - i)));
+  }
+}
+
+// returns exact color if frame buffer is used, else lossy restored color from bus
 uint32_t WS2812FX::getPixelColor(uint16_t i)
 {
   if (i < customMappingSize) i = customMappingTable[i];
   if (i >= _length) return 0;
+  if (_pixels) return _pixels[i];
   return busses.getPixelColor(i);
 }
 
+// pushes frame buffer to busses, each bus gets its range in one pass
+void WS2812FX::flushPixels() {
+  if (!_pixels || _directBusWrite) return;
+  for (uint8_t b = 0; b < busses.getNumBusses(); b++) {
+    Bus *bus = busses.getBus(b);
+    uint16_t start = bus->getStart();
+    if (start >= _length) continue;
+    bus->setPixels(0, _pixels + start, MIN(bus->getLength(), _length - start));
+  }
+}
+
 
 //DISCLAIMER
 //The following function attemps to calculate the current LED power usage,
@@ -1282,14 +1702,18 @@ uint8_t WS2812FX::estimateCurrentAndLimitBri() {
 
   size_t pLen = 0; //getLengthPhysical();
   size_t powerSum = 0;
+  const bool fromPixels = _pixels && !_directBusWrite; // busses are written by flushPixels() after this
   for (uint_fast8_t bNum = 0; bNum < busses.getNumBusses(); bNum++) {
     Bus *bus = busses.getBus(bNum);
     if (!IS_DIGITAL(bus->getType())) continue; //exclude non-digital network busses
     uint16_t len = bus->getLength();
     pLen += len;
+    uint16_t start = bus->getStart();
+    if (fromPixels) len = start < _length ? MIN(len, _length - start) : 0; // pixels past the strip stay black
     uint32_t busPowerSum = 0;
     for (uint_fast16_t i = 0; i < len; i++) { //sum up the usage of each LED
-      uint32_t c = bus->getPixelColor(i); // always returns original or restored color without brightness scaling
+      // exact color from the frame buffer, else original or restored color without brightness scaling from the bus
+      uint32_t c = fromPixels ? bus->busColor(_pixels[start + i]) : bus->getPixelColor(i);
       byte r = R(c), g = G(c), b = B(c), w = W(c);
 
       if(useWackyWS2815PowerModel) { //ignore white component on WS2815 power calculation
@@ -1334,7 +1758,13 @@ void WS2812FX::show(void) {
   if (callback) callback();
 
   uint8_t newBri = estimateCurrentAndLimitBri();
-  busses.setBrightness(newBri); // "repaints" all pixels if brightness changed
+  if (_pixels && !_directBusWrite) {
+    // every pixel is written at the limited brightness, nothing needs to be repainted
+    busses.setBrightness(newBri, false);
+    flushPixels();
+  } else {
+    busses.setBrightness(newBri); // "repaints" all pixels if brightness changed
+  }
 
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
@@ -1344,7 +1774,8 @@ void WS2812FX::show(void) {
   // restore bus brightness to its original value
   // this is done right after show, so this is only OK if LED updates are completed before show() returns
   // or async show has a separate buffer (ESP32 RMT and I2S are ok)
-  if (newBri < _brightness) busses.setBrightness(_brightness);
+  // with the frame buffer the busses keep the limited brightness until the next show() flushes it again
+  if (newBri < _brightness && !(_pixels && !_directBusWrite)) busses.setBrightness(_brightness);
 
   unsigned long showNow = millis();
   size_t diff = showNow - _lastShow;
@@ -1718,7 +2149,7 @@ void WS2812FX::printSize() {
   DEBUG_PRINTF("Data: %d*%d=%uB\n", sizeof(const char *), _modeData.size(), (_modeData.capacity()*sizeof(const char *)));
   DEBUG_PRINTF("Map: %d*%d=%uB\n", sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
   size = getLengthTotal();
-  if (useGlobalLedBuffer) DEBUG_PRINTF("Buffer: %d*%u=%uB\n", sizeof(CRGB), size, size*sizeof(CRGB));
+  if (_pixels) DEBUG_PRINTF("Buffer: %d*%u=%uB\n", sizeof(uint32_t), size, size*sizeof(uint32_t));
 }
 #endif
 
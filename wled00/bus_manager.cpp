@@ -6,7 +6,11 @@
 #include <IPAddress.h>
 #include "const.h"
 #include "pin_manager.h"
+#ifdef WLED_NATIVE
+#include "polybus_native.h" // in-memory busses for the host build
+#else
 #include "bus_wrapper.h"
+#endif
 #include "bus_manager.h"
 
 //colors.cpp
@@ -15,7 +19,9 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb);
 void colorRGBtoRGBW(byte* rgb);
 
 //udp.cpp
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, byte *buffer, uint8_t bri=255, bool isRGBW=false);
+byte *realtimeBroadcastPacket(uint8_t type, bool isRGBW);
+uint8_t realtimeBroadcast(uint8_t type, const IPAddress *clients, uint8_t numClients, uint16_t universe, uint16_t length, byte *buffer, uint8_t bri, bool isRGBW, byte *packet);
+void realtimeBroadcastSync(const IPAddress *clients, uint8_t numClients);
 
 // enable additional debug output
 #if defined(WLED_DEBUG_HOST)
@@ -74,6 +80,16 @@ uint8_t IRAM_ATTR ColorOrderMap::getPixelColorOrder(uint16_t pix, uint8_t defaul
   return defaultColorOrder;
 }
 
+void StreamMap::add(const StreamMapEntry &entry) {
+  if (_count >= WLED_MAX_STREAM_MAPPINGS) {
+    return;
+  }
+  if (entry.len == 0 || entry.type > 2 || !entry.ip[0]) {
+    return;
+  }
+  _mappings[_count++] = entry;
+}
+
 
 uint32_t Bus::autoWhiteCalc(uint32_t c) {
   uint8_t aWM = _autoWhiteMode;
@@ -91,6 +107,15 @@ uint32_t Bus::autoWhiteCalc(uint32_t c) {
   return RGBW32(r, g, b, w);
 }
 
+// generic bulk access, busses that can resolve their type-dependent path once per run override these
+void Bus::setPixels(uint16_t pix, const uint32_t* c, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) setPixelColor(pix + i, c[i]);
+}
+
+void Bus::getPixels(uint16_t pix, uint32_t* c, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) c[i] = getPixelColor(pix + i);
+}
+
 uint8_t *Bus::allocData(size_t size) {
   if (_data) free(_data); // should not happen, but for safety
   return _data = (uint8_t *)(size>0 ? calloc(size, sizeof(uint8_t)) : nullptr);
@@ -161,7 +186,8 @@ bool BusDigital::canShow() {
   return PolyBus::canShow(_busPtr, _iType);
 }
 
-void BusDigital::setBrightness(uint8_t b) {
+// repaint - rescale the pixels already set, false if all of them are set again before the next show()
+void BusDigital::setBrightness(uint8_t b, bool repaint) {
   if (_bri == b) return;
   //Fix for turning off onboard LED breaking bus
   #ifdef LED_BUILTIN
@@ -173,11 +199,11 @@ void BusDigital::setBrightness(uint8_t b) {
   Bus::setBrightness(b);
   PolyBus::setBrightness(_busPtr, _iType, b);
 
-  if (_buffering) return;
+  if (_buffering || !repaint) return;
 
   // must update/repaint every LED in the NeoPixelBus buffer to the new brightness
   // the only case where repainting is unnecessary is when all pixels are set after the brightness change but before the next show
-  // (which we can't rely on)
+  // (the caller tells us with repaint = false)
   uint16_t hwLen = _len;
   if (_type == TYPE_WS2812_1CH_X3) hwLen = NUM_ICS_WS2812_1CH_3X(_len); // only needs a third of "RGB" LEDs for NeoPixelBus
   for (uint_fast16_t i = 0; i < hwLen; i++) {
@@ -227,6 +253,30 @@ void IRAM_ATTR BusDigital::setPixelColor(uint16_t pix, uint32_t c) {
   }
 }
 
+// same as setPixelColor() for count consecutive pixels, but white/CCT handling and color order are resolved once
+void IRAM_ATTR BusDigital::setPixels(uint16_t pix, const uint32_t* c, uint16_t count) {
+  if (!_valid || pix >= _len) return;
+  if (count > _len - pix) count = _len - pix;
+  if (_buffering || _type == TYPE_WS2812_1CH_X3) { // per channel/IC handling, no gain here
+    Bus::setPixels(pix, c, count);
+    return;
+  }
+  const bool autoWhite = hasAutoWhite();
+  const bool balance   = _cct >= 1900;
+  const bool mapped    = _colorOrderMap.count() > 0;
+  uint8_t co = _colorOrder;
+  for (uint16_t i = 0; i < count; i++) {
+    uint32_t col = c[i];
+    if (autoWhite) col = autoWhiteCalc(col);
+    if (balance)   col = colorBalanceFromKelvin(_cct, col); //color correction from CCT
+    uint16_t p = pix + i;
+    if (_reversed) p = _len - p -1;
+    p += _skip;
+    if (mapped) co = _colorOrderMap.getPixelColorOrder(p+_start, _colorOrder);
+    PolyBus::setPixelColor(_busPtr, _iType, p, col, co);
+  }
+}
+
 // returns original color if global buffering is enabled, else returns lossly restored color from bus
 uint32_t BusDigital::getPixelColor(uint16_t pix) {
   if (!_valid) return 0;
@@ -298,7 +348,7 @@ BusPwm::BusPwm(BusConfig &bc)
   #ifdef ESP8266
   analogWriteRange(255);  //same range as one RGB channel
   analogWriteFreq(_frequency);
-  #else
+  #elif defined(ARDUINO_ARCH_ESP32)
   _ledcStart = pinManager.allocateLedc(numPins);
   if (_ledcStart == 255) { //no more free LEDC channels
     deallocatePins(); return;
@@ -313,7 +363,7 @@ BusPwm::BusPwm(BusConfig &bc)
     _pins[i] = currentPin; //store only after allocatePin() succeeds
     #ifdef ESP8266
     pinMode(_pins[i], OUTPUT);
-    #else
+    #elif defined(ARDUINO_ARCH_ESP32)
     ledcSetup(_ledcStart + i, _frequency, 8);
     ledcAttachPin(_pins[i], _ledcStart + i);
     #endif
@@ -389,7 +439,7 @@ void BusPwm::show() {
     if (_reversed) scaled = 255 - scaled;
     #ifdef ESP8266
     analogWrite(_pins[i], scaled);
-    #else
+    #elif defined(ARDUINO_ARCH_ESP32)
     ledcWrite(_ledcStart + i, scaled);
     #endif
   }
@@ -411,7 +461,7 @@ void BusPwm::deallocatePins() {
     if (!pinManager.isPinOk(_pins[i])) continue;
     #ifdef ESP8266
     digitalWrite(_pins[i], LOW); //turn off PWM interrupt
-    #else
+    #elif defined(ARDUINO_ARCH_ESP32)
     if (_ledcStart < 16) ledcDetachPin(_pins[i]);
     #endif
   }
@@ -467,6 +517,7 @@ uint8_t BusOnOff::getPins(uint8_t* pinArray) {
 BusNetwork::BusNetwork(BusConfig &bc)
 : Bus(bc.type, bc.start, bc.autoWhite, bc.count)
 , _broadcastLock(false)
+, _packet(nullptr)
 {
   switch (bc.type) {
     case TYPE_NET_ARTNET_RGB:
@@ -483,8 +534,14 @@ BusNetwork::BusNetwork(BusConfig &bc)
       break;
   }
   _UDPchannels = _rgbw ? 4 : 3;
-  _client = IPAddress(bc.pins[0],bc.pins[1],bc.pins[2],bc.pins[3]);
-  _valid = (allocData(_len * _UDPchannels) != nullptr);
+  _universe = bc.universe;
+  _client[0] = IPAddress(bc.pins[0],bc.pins[1],bc.pins[2],bc.pins[3]);
+  _numClients = 1;
+  for (uint8_t i = 0; i < bc.numDest && i < WLED_MAX_NET_DESTINATIONS-1; i++) {
+    if (bc.dest[i][0]) _client[_numClients++] = bc.dest[i]; // skip unset addresses
+  }
+  _packet = realtimeBroadcastPacket(_UDPtype, _rgbw);
+  _valid = (_packet != nullptr && allocData(_len * _UDPchannels) != nullptr);
 }
 
 void BusNetwork::setPixelColor(uint16_t pix, uint32_t c) {
@@ -504,24 +561,214 @@ uint32_t BusNetwork::getPixelColor(uint16_t pix) {
   return RGBW32(_data[offset], _data[offset+1], _data[offset+2], (_rgbw ? _data[offset+3] : 0));
 }
 
+void BusNetwork::setPixels(uint16_t pix, const uint32_t* c, uint16_t count) {
+  if (!_valid || pix >= _len) return;
+  if (count > _len - pix) count = _len - pix;
+  const bool autoWhite = hasAutoWhite();
+  const bool balance   = _cct >= 1900;
+  uint8_t *data = _data + pix * _UDPchannels;
+  for (uint16_t i = 0; i < count; i++) {
+    uint32_t col = c[i];
+    if (autoWhite) col = autoWhiteCalc(col);
+    if (balance)   col = colorBalanceFromKelvin(_cct, col); //color correction from CCT
+    *data++ = R(col);
+    *data++ = G(col);
+    *data++ = B(col);
+    if (_rgbw) *data++ = W(col);
+  }
+}
+
+void BusNetwork::getPixels(uint16_t pix, uint32_t* c, uint16_t count) {
+  if (!_valid || pix >= _len) return;
+  if (count > _len - pix) count = _len - pix;
+  const uint8_t *data = _data + pix * _UDPchannels;
+  for (uint16_t i = 0; i < count; i++, data += _UDPchannels) {
+    c[i] = RGBW32(data[0], data[1], data[2], (_rgbw ? data[3] : 0));
+  }
+}
+
 void BusNetwork::show() {
   if (!_valid || !canShow()) return;
   _broadcastLock = true;
-  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, _rgbw);
+  bool ok = !realtimeBroadcast(_UDPtype, _client, _numClients, _universe, _len, _data, _bri, _rgbw, _packet);
+  if (ok && _UDPtype == 2) realtimeBroadcastSync(_client, _numClients); // latch the frame on our Art-Net nodes
   _broadcastLock = false;
 }
 
 uint8_t BusNetwork::getPins(uint8_t* pinArray) {
   for (uint8_t i = 0; i < 4; i++) {
-    pinArray[i] = _client[i];
+    pinArray[i] = _client[0][i];
   }
   return 4;
 }
 
+uint8_t BusNetwork::getDestinations(IPAddress* dest) {
+  for (uint8_t i = 1; i < _numClients; i++) dest[i-1] = _client[i];
+  return _numClients - 1;
+}
+
 void BusNetwork::cleanup() {
   _type = I_NONE;
   _valid = false;
   freeData();
+  free(_packet);
+  _packet = nullptr;
+}
+
+
+// pixel stream buffers can be large, they go to PSRAM if it is available
+static void *streamAlloc(size_t size) {
+  #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+  if (psramFound()) return ps_calloc(size, 1);
+  #endif
+  return calloc(size, 1);
+}
+
+BusStream::BusStream(BusConfig &bc, const StreamMap &map)
+: Bus(bc.type, bc.start, bc.autoWhite, bc.count)
+, _map(map)
+, _frame(nullptr)
+, _frameSize(0)
+, _sendBri(255)
+, _sendNext(0)
+, _sendSpread(0)
+, _sendStart(0)
+{
+  _sending.reset();
+  memset(_packet, 0, sizeof(_packet));
+  _data = (uint8_t *)streamAlloc(_len * sizeof(uint32_t)); // one RGBW32 value per pixel
+  _valid = _data != nullptr;
+}
+
+void BusStream::setPixelColor(uint16_t pix, uint32_t c) {
+  if (!_valid || pix >= _len) return;
+  if (hasAutoWhite()) c = autoWhiteCalc(c);
+  if (_cct >= 1900) c = colorBalanceFromKelvin(_cct, c); //color correction from CCT
+  ((uint32_t *)_data)[pix] = c;
+}
+
+uint32_t BusStream::getPixelColor(uint16_t pix) {
+  if (!_valid || pix >= _len) return 0;
+  return ((uint32_t *)_data)[pix];
+}
+
+void BusStream::setPixels(uint16_t pix, const uint32_t* c, uint16_t count) {
+  if (!_valid || pix >= _len) return;
+  if (count > _len - pix) count = _len - pix;
+  const bool autoWhite = hasAutoWhite();
+  const bool balance   = _cct >= 1900;
+  uint32_t *data = (uint32_t *)_data + pix;
+  if (!autoWhite && !balance) {
+    memcpy(data, c, count * sizeof(uint32_t));
+    return;
+  }
+  for (uint16_t i = 0; i < count; i++) {
+    uint32_t col = c[i];
+    if (autoWhite) col = autoWhiteCalc(col);
+    if (balance)   col = colorBalanceFromKelvin(_cct, col); //color correction from CCT
+    data[i] = col;
+  }
+}
+
+void BusStream::getPixels(uint16_t pix, uint32_t* c, uint16_t count) {
+  if (!_valid || pix >= _len) return;
+  if (count > _len - pix) count = _len - pix;
+  memcpy(c, (uint32_t *)_data + pix, count * sizeof(uint32_t));
+}
+
+// takes a snapshot of the ranges in the channel layout of their protocol, loop() sends them
+void BusStream::show() {
+  if (!_valid) return;
+  sendRanges(_sending.count()); // the previous frame has not been sent completely yet
+  unsigned long now = millis();
+  // spread the ranges over 3/4 of the previous frame interval, so the frame is out before the next one
+  _sendSpread = MIN(now - _sendStart, 100UL) * 3 / 4;
+  _sendStart = now;
+
+  _sending.reset();
+  size_t size = 0;
+  for (uint8_t i = 0; i < _map.count(); i++) {
+    const StreamMapEntry *e = _map.get(i);
+    if (e->start < _start || e->start + e->len > _start + _len) continue; // not (completely) on this bus
+    _frameOfs[_sending.count()] = size;
+    _sending.add(*e);
+    size += e->len * (e->rgbw ? 4 : 3);
+  }
+  if (size > _frameSize) {
+    free(_frame);
+    _frame = (uint8_t *)streamAlloc(size);
+    _frameSize = _frame ? size : 0;
+    if (!_frame) {
+      DEBUG_PRINTLN(F("Not enough RAM for pixel stream!"));
+      _sending.reset();
+      return;
+    }
+  }
+
+  const uint32_t *pixels = (const uint32_t *)_data;
+  for (uint8_t i = 0; i < _sending.count(); i++) {
+    const StreamMapEntry *e = _sending.get(i);
+    const uint32_t *c = pixels + (e->start - _start);
+    uint8_t *out = _frame + _frameOfs[i];
+    for (uint16_t j = 0; j < e->len; j++) {
+      *out++ = R(c[j]);
+      *out++ = G(c[j]);
+      *out++ = B(c[j]);
+      if (e->rgbw) *out++ = W(c[j]);
+    }
+  }
+  _sendBri = _bri; // brightness may change before the frame is out
+  _sendNext = 0;
+  loop();
+}
+
+// sends the ranges that are due by now, evenly spaced over _sendSpread ms after show()
+void BusStream::loop() {
+  if (_sendNext >= _sending.count()) return;
+  if (!_sendSpread) {
+    sendRanges(_sending.count());
+    return;
+  }
+  unsigned long due = 1 + (millis() - _sendStart) * _sending.count() / _sendSpread;
+  sendRanges(MIN(due, (unsigned long)_sending.count()));
+}
+
+// sends the ranges before upTo that have not been sent yet
+void BusStream::sendRanges(uint8_t upTo) {
+  if (_sendNext >= upTo) return;
+  for (; _sendNext < upTo; _sendNext++) {
+    const StreamMapEntry *e = _sending.get(_sendNext);
+    byte *&packet = _packet[e->type][e->rgbw];
+    if (!packet) packet = realtimeBroadcastPacket(e->type, e->rgbw);
+    _sendOk[_sendNext] = !realtimeBroadcast(e->type, &e->ip, 1, e->offset, e->len, _frame + _frameOfs[_sendNext], _sendBri, e->rgbw, packet);
+  }
+  if (_sendNext < _sending.count()) return;
+  // latch the frame on the Art-Net nodes that received all of their ranges, one ArtSync per node
+  for (uint8_t i = 0; i < _sending.count(); i++) {
+    const StreamMapEntry *e = _sending.get(i);
+    if (e->type != 2) continue;
+    bool sync = true;
+    for (uint8_t j = 0; j < _sending.count() && sync; j++) {
+      const StreamMapEntry *o = _sending.get(j);
+      if (o->type != 2 || o->ip != e->ip) continue;
+      sync = j >= i && _sendOk[j]; // not the first range of this node or a range was not sent
+    }
+    if (sync) realtimeBroadcastSync(&e->ip, 1);
+  }
+}
+
+void BusStream::cleanup() {
+  _type = I_NONE;
+  _valid = false;
+  _sending.reset();
+  freeData();
+  free(_frame);
+  _frame = nullptr;
+  _frameSize = 0;
+  for (uint8_t t = 0; t < 3; t++) {
+    free(_packet[t][0]); _packet[t][0] = nullptr;
+    free(_packet[t][1]); _packet[t][1] = nullptr;
+  }
 }
 
 
@@ -544,12 +791,20 @@ uint32_t BusManager::memUsage(BusConfig &bc) {
     #endif
   }
   if (type > 31 && type < 48) return 5;
+  if (type == TYPE_NET_STREAM) {
+    #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+    if (psramFound()) return 0; // see streamAlloc()
+    #endif
+    return len*8; // pixels and the frame being sent
+  }
   return len*3; //RGB
 }
 
 int BusManager::add(BusConfig &bc) {
   if (getNumBusses() - getNumVirtualBusses() >= WLED_MAX_BUSSES) return -1;
-  if (bc.type >= TYPE_NET_DDP_RGB && bc.type < 96) {
+  if (bc.type == TYPE_NET_STREAM) {
+    busses[numBusses] = new BusStream(bc, streamMap);
+  } else if (bc.type >= TYPE_NET_DDP_RGB && bc.type < 96) {
     busses[numBusses] = new BusNetwork(bc);
   } else if (IS_DIGITAL(bc.type)) {
     busses[numBusses] = new BusDigital(bc, numBusses, colorOrderMap);
@@ -576,6 +831,13 @@ void BusManager::show() {
   }
 }
 
+// lets busses send frames in parts between two show() calls
+void BusManager::loop() {
+  for (uint8_t i = 0; i < numBusses; i++) {
+    busses[i]->loop();
+  }
+}
+
 void BusManager::setStatusPixel(uint32_t c) {
   for (uint8_t i = 0; i < numBusses; i++) {
     busses[i]->setStatusPixel(c);
@@ -591,9 +853,22 @@ void IRAM_ATTR BusManager::setPixelColor(uint16_t pix, uint32_t c) {
   }
 }
 
-void BusManager::setBrightness(uint8_t b) {
+// writes count consecutive pixels starting at pix, each bus receives its part of the span in one call
+void IRAM_ATTR BusManager::setPixels(uint16_t pix, const uint32_t* c, uint16_t count) {
+  uint32_t end = pix + count;
   for (uint8_t i = 0; i < numBusses; i++) {
-    busses[i]->setBrightness(b);
+    Bus* b = busses[i];
+    uint32_t bstart = b->getStart();
+    uint32_t from = MAX(bstart, pix);
+    uint32_t to   = MIN(bstart + b->getLength(), end);
+    if (from >= to) continue;
+    b->setPixels(from - bstart, c + (from - pix), to - from);
+  }
+}
+
+void BusManager::setBrightness(uint8_t b, bool repaint) {
+  for (uint8_t i = 0; i < numBusses; i++) {
+    busses[i]->setBrightness(b, repaint);
   }
 }
 
@@ -616,6 +891,20 @@ uint32_t BusManager::getPixelColor(uint16_t pix) {
   return 0;
 }
 
+// reads count consecutive pixels starting at pix, pixels not belonging to any bus are 0
+void BusManager::getPixels(uint16_t pix, uint32_t* c, uint16_t count) {
+  uint32_t end = pix + count;
+  memset(c, 0, count * sizeof(uint32_t));
+  for (int i = numBusses - 1; i >= 0; i--) { // reverse, so the first bus containing a pixel wins like in getPixelColor()
+    Bus* b = busses[i];
+    uint32_t bstart = b->getStart();
+    uint32_t from = MAX(bstart, pix);
+    uint32_t to   = MIN(bstart + b->getLength(), end);
+    if (from >= to) continue;
+    b->getPixels(from - bstart, c + (from - pix), to - from);
+  }
+}
+
 bool BusManager::canAllShow() {
   for (uint8_t i = 0; i < numBusses; i++) {
     if (!busses[i]->canShow()) return false;
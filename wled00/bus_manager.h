@@ -35,6 +35,9 @@ struct BusConfig {
   uint8_t pins[5] = {LEDPIN, 255, 255, 255, 255};
   uint16_t frequency;
   bool doubleBuffer;
+  uint16_t universe = 0; // network busses: first E1.31 universe, Art-Net port address (0 = protocol default) or DDP pixel offset
+  uint8_t numDest = 0;   // network busses: additional destinations (the first one is stored in pins)
+  IPAddress dest[WLED_MAX_NET_DESTINATIONS-1];
 
   BusConfig(uint8_t busType, uint8_t* ppins, uint16_t pstart, uint16_t len = 1, uint8_t pcolorOrder = COL_ORDER_GRB, bool rev = false, uint8_t skip = 0, byte aw=RGBW_MODE_MANUAL_ONLY, uint16_t clock_kHz=0U, bool dblBfr=false)
   : count(len)
@@ -58,7 +61,7 @@ struct BusConfig {
   //validates start and length and extends total if needed
   bool adjustBounds(uint16_t& total) {
     if (!count) count = 1;
-    if (count > MAX_LEDS_PER_BUS) count = MAX_LEDS_PER_BUS;
+    if (count > MAX_LEDS_PER_BUS && type != TYPE_NET_STREAM) count = MAX_LEDS_PER_BUS; // a pixel stream is only limited by MAX_LEDS
     if (start >= MAX_LEDS) return false;
     //limit length of strip if it would exceed total permissible LEDs
     if (start + count > MAX_LEDS) count = MAX_LEDS - start;
@@ -101,7 +104,39 @@ struct ColorOrderMap {
 };
 
 
-//parent class of BusDigital, BusPwm, and BusNetwork
+// A range of pixels a pixel stream bus sends to another node.
+struct StreamMapEntry {
+  uint16_t  start;  // first pixel of the range (strip index)
+  uint16_t  len;
+  uint16_t  offset; // first pixel on the node (DDP), first universe (E1.31) or Art-Net port address
+  uint8_t   type;   // protocol: 0=DDP, 1=E1.31, 2=Art-Net (as realtimeBroadcast())
+  bool      rgbw;
+  IPAddress ip;
+};
+
+struct StreamMap {
+    void add(const StreamMapEntry &entry);
+
+    uint8_t count() const { return _count; }
+
+    void reset() {
+      _count = 0;
+    }
+
+    const StreamMapEntry* get(uint8_t n) const {
+      if (n >= _count) {
+        return nullptr;
+      }
+      return &(_mappings[n]);
+    }
+
+  private:
+    uint8_t _count;
+    StreamMapEntry _mappings[WLED_MAX_STREAM_MAPPINGS];
+};
+
+
+//parent class of BusDigital, BusPwm, BusNetwork and BusStream
 class Bus {
   public:
     Bus(uint8_t type, uint16_t start, uint8_t aw, uint16_t len = 1, bool reversed = false, bool refresh = false)
@@ -120,11 +155,14 @@ class Bus {
     virtual ~Bus() {} //throw the bus under the bus
 
     virtual void     show() = 0;
+    virtual void     loop()                      {} // called from the main loop between frames
     virtual bool     canShow()                   { return true; }
     virtual void     setStatusPixel(uint32_t c)  {}
     virtual void     setPixelColor(uint16_t pix, uint32_t c) = 0;
     virtual uint32_t getPixelColor(uint16_t pix) { return 0; }
-    virtual void     setBrightness(uint8_t b)    { _bri = b; };
+    virtual void     setPixels(uint16_t pix, const uint32_t* c, uint16_t count);
+    virtual void     getPixels(uint16_t pix, uint32_t* c, uint16_t count);
+    virtual void     setBrightness(uint8_t b, bool repaint = true) { _bri = b; };
     virtual void     cleanup() = 0;
     virtual uint8_t  getPins(uint8_t* pinArray)  { return 0; }
     virtual uint16_t getLength()                 { return _len; }
@@ -132,6 +170,8 @@ class Bus {
     virtual uint8_t  getColorOrder()             { return COL_ORDER_RGB; }
     virtual uint8_t  skippedLeds()               { return 0; }
     virtual uint16_t getFrequency()              { return 0U; }
+    virtual uint16_t getUniverse()               { return 0U; }
+    virtual uint8_t  getDestinations(IPAddress* dest) { return 0; }
     inline  void     setReversed(bool reversed)  { _reversed = reversed; }
     inline  uint16_t getStart()                  { return _start; }
     inline  void     setStart(uint16_t start)    { _start = start; }
@@ -139,6 +179,7 @@ class Bus {
     inline  bool     isOk()                      { return _valid; }
     inline  bool     isReversed()                { return _reversed; }
     inline  bool     isOffRefreshRequired()      { return _needsRefresh; }
+    inline  uint32_t busColor(uint32_t c)        { return hasAutoWhite() ? autoWhiteCalc(c) : c; } // as stored by setPixelColor()
             bool     containsPixel(uint16_t pix) { return pix >= _start && pix < _start+_len; }
 
     virtual bool hasRGB(void) { return Bus::hasRGB(_type); }
@@ -150,7 +191,7 @@ class Bus {
     static  bool hasWhite(uint8_t type) {
       if ((type >= TYPE_WS2812_1CH && type <= TYPE_WS2812_WWA) || type == TYPE_SK6812_RGBW || type == TYPE_TM1814 || type == TYPE_UCS8904) return true; // digital types with white channel
       if (type > TYPE_ONOFF && type <= TYPE_ANALOG_5CH && type != TYPE_ANALOG_3CH) return true; // analog types with white channel
-      if (type == TYPE_NET_DDP_RGBW) return true; // network types with white channel
+      if (type == TYPE_NET_DDP_RGBW || type == TYPE_NET_STREAM) return true; // network types with white channel
       return false;
     }
     virtual bool hasCCT(void) { return Bus::hasCCT(_type); }
@@ -190,6 +231,7 @@ class Bus {
     static uint8_t _cctBlend;
 
     uint32_t autoWhiteCalc(uint32_t c);
+    inline bool hasAutoWhite() { return Bus::hasWhite(_type) && (_gAWM != AW_GLOBAL_DISABLED ? _gAWM : _autoWhiteMode) != RGBW_MODE_MANUAL_ONLY; }
     uint8_t *allocData(size_t size = 1);
     void     freeData() { if (_data != nullptr) free(_data); _data = nullptr; }
 };
@@ -202,9 +244,10 @@ class BusDigital : public Bus {
 
     void show();
     bool canShow();
-    void setBrightness(uint8_t b);
+    void setBrightness(uint8_t b, bool repaint = true);
     void setStatusPixel(uint32_t c);
     void setPixelColor(uint16_t pix, uint32_t c);
+    void setPixels(uint16_t pix, const uint32_t* c, uint16_t count);
     void setColorOrder(uint8_t colorOrder);
     uint32_t getPixelColor(uint16_t pix);
     uint8_t  getColorOrder() { return _colorOrder; }
@@ -288,16 +331,57 @@ class BusNetwork : public Bus {
     bool canShow()  { return !_broadcastLock; } // this should be a return value from UDP routine if it is still sending data out
     void setPixelColor(uint16_t pix, uint32_t c);
     uint32_t getPixelColor(uint16_t pix);
+    void setPixels(uint16_t pix, const uint32_t* c, uint16_t count);
+    void getPixels(uint16_t pix, uint32_t* c, uint16_t count);
     uint8_t  getPins(uint8_t* pinArray);
+    uint16_t getUniverse() { return _universe; }
+    uint8_t  getDestinations(IPAddress* dest);
     void show();
     void cleanup();
 
   private:
-    IPAddress _client;
+    IPAddress _client[WLED_MAX_NET_DESTINATIONS]; // first one is the configured IP ("pins")
+    uint8_t   _numClients;
+    uint16_t  _universe;
     uint8_t   _UDPtype;
     uint8_t   _UDPchannels;
     bool      _rgbw;
     bool      _broadcastLock;
+    byte     *_packet; // one prebuilt packet, see realtimeBroadcastPacket()
+};
+
+
+// Sends ranges of its pixels to other nodes (see StreamMap), so effects for a large layout can be rendered
+// once and displayed by many nodes. The ranges of a frame are sent spread over the following frame interval.
+class BusStream : public Bus {
+  public:
+    BusStream(BusConfig &bc, const StreamMap &map);
+    ~BusStream() { cleanup(); }
+
+    bool hasRGB()   { return true; }
+    bool hasWhite() { return true; }
+    void setPixelColor(uint16_t pix, uint32_t c);
+    uint32_t getPixelColor(uint16_t pix);
+    void setPixels(uint16_t pix, const uint32_t* c, uint16_t count);
+    void getPixels(uint16_t pix, uint32_t* c, uint16_t count);
+    void show();
+    void loop();
+    void cleanup();
+
+  private:
+    const StreamMap &_map;
+    StreamMap _sending;                           // ranges of the frame being sent (the map may change meanwhile)
+    uint32_t  _frameOfs[WLED_MAX_STREAM_MAPPINGS]; // position of each range in _frame
+    bool      _sendOk[WLED_MAX_STREAM_MAPPINGS];   // range of _sending has been sent without error
+    uint8_t  *_frame;                             // channel data of the frame being sent
+    size_t    _frameSize;
+    byte     *_packet[3][2];                      // one packet per protocol and RGB/RGBW, see realtimeBroadcastPacket()
+    uint8_t   _sendBri;
+    uint8_t   _sendNext;                          // next range of _sending to send
+    uint16_t  _sendSpread;                        // ms the ranges of a frame are spread over
+    unsigned long _sendStart;
+
+    void sendRanges(uint8_t upTo);
 };
 
 
@@ -314,12 +398,15 @@ class BusManager {
     void removeAll();
 
     void show();
+    void loop();
     bool canAllShow();
     void setStatusPixel(uint32_t c);
     void setPixelColor(uint16_t pix, uint32_t c);
-    void setBrightness(uint8_t b);
+    void setPixels(uint16_t pix, const uint32_t* c, uint16_t count);
+    void setBrightness(uint8_t b, bool repaint = true);
     void setSegmentCCT(int16_t cct, bool allowWBCorrection = false);
     uint32_t getPixelColor(uint16_t pix);
+    void getPixels(uint16_t pix, uint32_t* c, uint16_t count);
 
     Bus* getBus(uint8_t busNr);
 
@@ -330,10 +417,14 @@ class BusManager {
     inline void                 updateColorOrderMap(const ColorOrderMap &com) { memcpy(&colorOrderMap, &com, sizeof(ColorOrderMap)); }
     inline const ColorOrderMap& getColorOrderMap() const { return colorOrderMap; }
 
+    inline void             updateStreamMap(const StreamMap &sm) { streamMap = sm; }
+    inline const StreamMap& getStreamMap() const { return streamMap; }
+
   private:
     uint8_t numBusses;
     Bus* busses[WLED_MAX_BUSSES+WLED_MIN_VIRTUAL_BUSSES];
     ColorOrderMap colorOrderMap;
+    StreamMap streamMap;
 
     inline uint8_t getNumVirtualBusses() {
       int j = 0;
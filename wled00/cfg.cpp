@@ -89,7 +89,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(strip.cctBlending, hw_led[F("cb")]);
   Bus::setCCTBlend(strip.cctBlending);
   strip.setTargetFps(hw_led["fps"]); //NOP if 0, default 42 FPS
-  CJSON(useGlobalLedBuffer, hw_led[F("ld")]);
+  CJSON(useGlobalLedBuffer, hw_led[F("ld")]); // WS2812FX frame buffer (busses are never double buffered)
+  CJSON(netOutputPacing, hw_led[F("np")]);
 
   #ifndef WLED_DISABLE_2D
   // 2D Matrix Settings
@@ -159,17 +160,23 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       uint16_t freqkHz = elm[F("freq")] | 0;  // will be in kHz for DotStar and Hz for PWM (not yet implemented fully)
       ledType |= refresh << 7; // hack bit 7 to indicate strip requires off refresh
       uint8_t AWmode = elm[F("rgbwm")] | RGBW_MODE_MANUAL_ONLY;
+      uint16_t universe = elm[F("uni")] | 0; // network busses: first E1.31 universe, Art-Net port address or DDP pixel offset
+      JsonArray dstArr = elm[F("dst")];      // network busses: additional destination IPs
       if (fromFS) {
-        BusConfig bc = BusConfig(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, useGlobalLedBuffer);
+        BusConfig bc = BusConfig(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz); // global buffer is owned by WS2812FX, no bus level double buffering
+        bc.universe = universe;
+        for (const char *ip : dstArr) if (ip && bc.numDest < WLED_MAX_NET_DESTINATIONS-1 && bc.dest[bc.numDest].fromString(ip)) bc.numDest++;
         mem += BusManager::memUsage(bc);
         if (useGlobalLedBuffer && start + length > maxlen) {
           maxlen = start + length;
-          globalBufMem = maxlen * 4;
+          globalBufMem = WS2812FX::frameBufferMem(maxlen);
         }
         if (mem + globalBufMem <= MAX_LED_MEMORY) if (busses.add(bc) == -1) break;  // finalization will be done in WLED::beginStrip()
       } else {
         if (busConfigs[s] != nullptr) delete busConfigs[s];
-        busConfigs[s] = new BusConfig(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, useGlobalLedBuffer);
+        busConfigs[s] = new BusConfig(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz);
+        busConfigs[s]->universe = universe;
+        for (const char *ip : dstArr) if (ip && busConfigs[s]->numDest < WLED_MAX_NET_DESTINATIONS-1 && busConfigs[s]->dest[busConfigs[s]->numDest].fromString(ip)) busConfigs[s]->numDest++;
         busesChanged = true;
       }
       s++;
@@ -179,6 +186,24 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   }
   if (hw_led["rev"]) busses.getBus(0)->setReversed(true); //set 0.11 global reversed setting for first bus
 
+  // read pixel stream map (ranges of pixel stream busses sent to other nodes)
+  JsonArray hw_stream = hw_led[F("stream")];
+  if (!hw_stream.isNull()) {
+    StreamMap sm = {};
+    for (JsonObject entry : hw_stream) {
+      StreamMapEntry e;
+      e.start  = entry["start"] | 0;
+      e.len    = entry["len"] | 0;
+      e.offset = entry[F("ofs")] | 0;
+      e.type   = entry["type"] | 0;
+      e.rgbw   = entry[F("rgbw")] | false;
+      const char *ip = entry["ip"];
+      if (!ip || !e.ip.fromString(ip)) continue;
+      sm.add(e);
+    }
+    busses.updateStreamMap(sm);
+  }
+
   // read color order map configuration
   JsonArray hw_com = hw[F("com")];
   if (!hw_com.isNull()) {
@@ -384,6 +409,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject if_sync = interfaces["sync"];
   CJSON(udpPort, if_sync[F("port0")]); // 21324
   CJSON(udpPort2, if_sync[F("port1")]); // 65506
+  CJSON(syncMulticast, if_sync[F("mc")]);
+  CJSON(strip.lockstep, if_sync[F("lockstep")]);
+  CJSON(strip.lockstepSeed, if_sync[F("lsseed")]);
 
   JsonObject if_sync_recv = if_sync["recv"];
   CJSON(receiveNotificationBrightness, if_sync_recv["bri"]);
@@ -406,6 +434,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(syncGroups, if_sync_send["grp"]);
   if (if_sync_send[F("twice")]) udpNumRetries = 1; // import setting from 0.13 and earlier
   CJSON(udpNumRetries, if_sync_send["ret"]);
+  CJSON(syncDeltaPackets, if_sync_send[F("delta")]);
 
   JsonObject if_nodes = interfaces["nodes"];
   CJSON(nodeListEnabled, if_nodes[F("list")]);
@@ -431,6 +460,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
 
   tdd = if_live[F("timeout")] | -1;
   if (tdd >= 0) realtimeTimeoutMs = tdd * 100;
+  CJSON(realtimeFrameTimeoutMs, if_live[F("ftimeout")]);
+  CJSON(udpRgbFormat, if_live[F("rawfmt")]);
   CJSON(arlsForceMaxBri, if_live[F("maxbri")]);
   CJSON(arlsDisableGammaCorrection, if_live[F("no-gc")]); // false
   CJSON(arlsOffset, if_live[F("offset")]); // 0
@@ -720,6 +751,7 @@ void serializeConfig() {
   hw_led["fps"] = strip.getTargetFps();
   hw_led[F("rgbwm")] = Bus::getGlobalAWMode(); // global auto white mode override
   hw_led[F("ld")] = useGlobalLedBuffer;
+  hw_led[F("np")] = netOutputPacing;
 
   #ifndef WLED_DISABLE_2D
   // 2D Matrix Settings
@@ -760,6 +792,27 @@ void serializeConfig() {
     ins["ref"] = bus->isOffRefreshRequired();
     ins[F("rgbwm")] = bus->getAutoWhiteMode();
     ins[F("freq")] = bus->getFrequency();
+    uint8_t type = bus->getType() & 0x7F;
+    if (type >= TYPE_NET_DDP_RGB && type < 96) {
+      ins[F("uni")] = bus->getUniverse();
+      IPAddress dest[WLED_MAX_NET_DESTINATIONS-1];
+      uint8_t nDest = bus->getDestinations(dest);
+      JsonArray ins_dst = ins.createNestedArray(F("dst"));
+      for (uint8_t i = 0; i < nDest; i++) ins_dst.add(dest[i].toString());
+    }
+  }
+
+  JsonArray hw_stream = hw_led.createNestedArray(F("stream"));
+  const StreamMap& sm = busses.getStreamMap();
+  for (uint8_t s = 0; s < sm.count(); s++) {
+    const StreamMapEntry *entry = sm.get(s);
+    JsonObject st = hw_stream.createNestedObject();
+    st["start"] = entry->start;
+    st["len"] = entry->len;
+    st[F("ofs")] = entry->offset;
+    st["type"] = entry->type;
+    st[F("rgbw")] = entry->rgbw;
+    st["ip"] = entry->ip.toString();
   }
 
   JsonArray hw_com = hw.createNestedArray(F("com"));
@@ -851,6 +904,9 @@ void serializeConfig() {
   JsonObject if_sync = interfaces.createNestedObject("sync");
   if_sync[F("port0")] = udpPort;
   if_sync[F("port1")] = udpPort2;
+  if_sync[F("mc")] = syncMulticast;
+  if_sync[F("lockstep")] = strip.lockstep;
+  if_sync[F("lsseed")] = strip.lockstepSeed;
 
   JsonObject if_sync_recv = if_sync.createNestedObject("recv");
   if_sync_recv["bri"] = receiveNotificationBrightness;
@@ -868,6 +924,7 @@ void serializeConfig() {
   if_sync_send["macro"] = notifyMacro;
   if_sync_send["grp"] = syncGroups;
   if_sync_send["ret"] = udpNumRetries;
+  if_sync_send[F("delta")] = syncDeltaPackets;
 
   JsonObject if_nodes = interfaces.createNestedObject("nodes");
   if_nodes[F("list")] = nodeListEnabled;
@@ -888,6 +945,8 @@ void serializeConfig() {
   if_live_dmx["mode"] = DMXMode;
 
   if_live[F("timeout")] = realtimeTimeoutMs / 100;
+  if_live[F("ftimeout")] = realtimeFrameTimeoutMs;
+  if_live[F("rawfmt")] = udpRgbFormat;
   if_live[F("maxbri")] = arlsForceMaxBri;
   if_live[F("no-gc")] = arlsDisableGammaCorrection;
   if_live[F("offset")] = arlsOffset;
@@ -67,22 +67,22 @@ uint32_t color_add(uint32_t c1, uint32_t c2, bool fast)
  */
 uint32_t color_fade(uint32_t c1, uint8_t amount, bool video)
 {
-  uint8_t r = R(c1);
-  uint8_t g = G(c1);
-  uint8_t b = B(c1);
-  uint8_t w = W(c1);
   if (video) {
+    uint8_t r = R(c1);
+    uint8_t g = G(c1);
+    uint8_t b = B(c1);
+    uint8_t w = W(c1);
     r = scale8_video(r, amount);
     g = scale8_video(g, amount);
     b = scale8_video(b, amount);
     w = scale8_video(w, amount);
-  } else {
-    r = scale8(r, amount);
-    g = scale8(g, amount);
-    b = scale8(b, amount);
-    w = scale8(w, amount);
+    return RGBW32(r, g, b, w);
   }
-  return RGBW32(r, g, b, w);
+  // scale8() of all 4 channels at once: a channel times amount+1 fits in 16 bits, so R/B and W/G can each share a word
+  uint32_t scale = uint32_t(amount) + 1;
+  uint32_t rb = (((c1 & 0x00FF00FF) * scale) >> 8) & 0x00FF00FF;
+  uint32_t wg = (((c1 >> 8) & 0x00FF00FF) * scale) & 0xFF00FF00;
+  return wg | rb;
 }
 
 void setRandomColor(byte* rgb)
@@ -324,7 +324,7 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb) {
     if (b < 186) return 3906 + (b-159) *22;
     if (b < 210) return 4500 + (b-186) *25;
     if (b < 230) return 5100 + (b-210) *30;
-                 return 5700 + (b-230) *34;
+    return 5700 + (b-230) *34;
   } else {
     //scale red up as if blue was at 255
     uint16_t scale = 0xFFFF / b; //get scale factor (range 257-65535)
@@ -362,6 +362,7 @@ void NeoGammaWLEDMethod::calcGammaTable(float gamma)
   for (size_t i = 0; i < 256; i++) {
     gammaT[i] = (int)(powf((float)i / 255.0f, gamma) * 255.0f + 0.5f);
   }
+  Segment::invalidatePaletteCache(); // color palettes were built with the old table
 }
 
 uint8_t NeoGammaWLEDMethod::Correct(uint8_t value)
@@ -66,6 +66,10 @@
   #endif
 #endif
 
+#ifndef WLED_MAX_NET_DESTINATIONS
+  #define WLED_MAX_NET_DESTINATIONS 4        // IP addresses a network bus can send its output to
+#endif
+
 #ifndef WLED_MAX_BUTTONS
   #ifdef ESP8266
     #define WLED_MAX_BUTTONS 2
@@ -80,6 +84,14 @@
 #define WLED_MAX_COLOR_ORDER_MAPPINGS 10
 #endif
 
+#ifndef WLED_MAX_STREAM_MAPPINGS
+  #ifdef ESP8266
+    #define WLED_MAX_STREAM_MAPPINGS 8
+  #else
+    #define WLED_MAX_STREAM_MAPPINGS 32      // pixel ranges a pixel stream bus can send to other nodes
+  #endif
+#endif
+
 #if defined(WLED_MAX_LEDMAPS) && (WLED_MAX_LEDMAPS > 32 || WLED_MAX_LEDMAPS < 10)
   #undef WLED_MAX_LEDMAPS
 #endif
@@ -194,6 +206,21 @@
 #define REALTIME_MODE_TPM2NET     7
 #define REALTIME_MODE_DDP         8
 
+//realtime input on dual core ESP32: Hyperion is received in its own task and frames are handed to the main loop
+//through a frame store (see udp.cpp)
+#if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_FREERTOS_UNICORE) && !defined(WLED_DISABLE_REALTIME_TASK)
+  #define WLED_REALTIME_TASK
+#endif
+
+//realtime input statistics (realtimeStats[])
+#define RT_STATS_E131             0
+#define RT_STATS_ARTNET           1
+#define RT_STATS_DDP              2
+#define RT_STATS_HYPERION         3
+#define RT_STATS_TPM2NET          4
+#define RT_STATS_PROTOCOLS        5
+#define RT_STATS_JITTER_BINS     12    // packet interval histogram: bin 0 < 256us, bin n < 256us<<n, last bin everything longer
+
 //realtime override modes
 #define REALTIME_OVERRIDE_NONE    0
 #define REALTIME_OVERRIDE_ONCE    1
@@ -257,6 +284,7 @@
 #define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus, unused)
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus, unused)
 #define TYPE_NET_DDP_RGBW        88            //network DDP RGBW bus (master broadcast bus)
+#define TYPE_NET_STREAM          95            //network pixel stream: ranges of pixels sent to other nodes (see StreamMap)
 
 #define IS_DIGITAL(t) ((t) & 0x10) //digital are 16-31 and 48-63
 #define IS_PWM(t)     ((t) > 40 && (t) < 46)
@@ -383,6 +411,8 @@
 #ifndef MAX_LEDS
 #ifdef ESP8266
 #define MAX_LEDS 1664 //can't rely on memory limit to limit this to 1600 LEDs
+#elif defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+#define MAX_LEDS 16384 //large layouts rendered for other nodes (pixel stream bus)
 #else
 #define MAX_LEDS 8192
 #endif
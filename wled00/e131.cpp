@@ -1,4 +1,7 @@
 #include "wled.h"
+#ifdef ARDUINO_ARCH_ESP32
+#include <lwip/priv/tcpip_priv.h> // tcpip_api_call()
+#endif
 
 #define MAX_3_CH_LEDS_PER_UNIVERSE 170
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
@@ -8,19 +11,331 @@
  * E1.31 handler
  */
 
+/*
+ * Realtime frame assembly
+ * Packets are written to the strip as they arrive, but the strip is shown only once per frame:
+ * when all universes of the frame have arrived, on the DDP PUSH flag, or on an E1.31 synchronization
+ * packet / ArtSync if the sender uses those. Frames that are not complete within realtimeFrameTimeoutMs
+ * (lost packets, senders without PUSH) are shown as they are. After such a timeout frames of the same
+ * synchronization universe are shown when complete, until one of its synchronization packets arrives.
+ * Hyperion/raw and TPM2.NET frames are complete with their last packet.
+ * A DDP PUSH with a timecode is shown at that time (if our clock is NTP synced and the frame goes through the
+ * realtime frame store), so that many nodes driven by one sender show their frames at the same moment.
+ */
+static uint32_t frameUniverses = 0;     // universes of the current frame received so far (bit 0 = e131Universe)
+static unsigned long frameStart = 0;    // micros() at the first packet of the current frame
+static unsigned long frameShownStart = 0; // frameStart of the frame waiting to be shown
+static uint8_t  frameProtocol = 0;      // RT_STATS_* protocol of the current frame
+static bool     framePending = false;   // packets of an unshown frame have been received
+static uint16_t frameSyncAddress = 0;   // E1.31 synchronization universe of the current frame (0 = not synchronized)
+static unsigned long lastArtSync = 0;   // millis() at the last ArtSync packet
+static uint32_t frameDDPChannels = 0;   // DDP channels received for the current frame
+static bool     ddpUsesPush = false;    // the DDP sender sets the PUSH flag, wait for it instead of counting channels
+static unsigned long frameDue = 0;      // millis() at which the completed frame is to be shown (DDP timecode), 0 = right away
+static uint16_t syncUniverse = 0;       // E1.31 synchronization universe the sender uses (multicast group joined for it)
+static uint16_t syncMissing = 0;        // synchronization universe whose sync packets did not arrive, its frames are not held
+
+#define ARTSYNC_TIMEOUT 4000 // Art-Net nodes leave synchronous mode if there was no ArtSync for 4 seconds
+#define DDP_TIMECODE_MAX_DELAY 1000 // ms, frames with a timecode further ahead are shown right away
+
+// delayMs - show the frame this many milliseconds from now instead of right away
+//           (only frames in the frame store can be held: pixels written to the strip directly would be
+//           overwritten by the next frame while waiting, and the frame would be shown torn)
+static void realtimeFrameComplete(uint16_t delayMs = 0) {
+  #ifdef WLED_REALTIME_TASK
+  if (!realtimeFrameStoreActive()) delayMs = 0;
+  realtimeFramePublish(); // hand the frame to the main loop
+  #else
+  delayMs = 0;
+  #endif
+  frameDue = delayMs ? (millis() + delayMs) | 1 : 0;
+  e131NewData = true;
+  frameShownStart = frameStart;
+  framePending = false;
+  frameUniverses = 0;
+  frameDDPChannels = 0;
+}
+
+// a frame was not complete in time, show what we have
+static void realtimeFrameTimeout() {
+  if (frameDDPChannels) ddpUsesPush = false; // no PUSH for a whole frame, count channels again
+  if (frameSyncAddress) syncMissing = frameSyncAddress; // don't hold further frames for a sync packet that does not come
+  realtimeFrameComplete();
+}
+
+static void realtimeFrameStart(uint8_t protocol) {
+  if (framePending && micros() - frameStart > realtimeFrameTimeoutMs * 1000UL) realtimeFrameTimeout();
+  if (framePending) return;
+  framePending = true;
+  frameStart = micros();
+  frameProtocol = protocol;
+}
+
+// returns true once per frame when the strip should be shown (called from handleNotifications())
+bool realtimeFrameReady() {
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestLock(); // frames are assembled in the receiving tasks
+  #endif
+  bool ready = false;
+  if (framePending && micros() - frameStart > realtimeFrameTimeoutMs * 1000UL) {
+    DEBUG_PRINTLN(F("Realtime frame timeout."));
+    realtimeFrameTimeout();
+  }
+  if (e131NewData && !(frameDue && (long)(millis() - frameDue) < 0)) { // wait for the DDP timecode
+    e131NewData = false;
+    realtimeStatsFrame(frameProtocol, frameShownStart);
+    ready = true;
+  }
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestUnlock();
+  #endif
+  return ready;
+}
+
+// a packet of a frame has been received (Hyperion/raw, TPM2.NET)
+// last - the packet completes the frame (every packet does if frames are not split)
+void realtimeFramePacket(uint8_t protocol, bool last) {
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestLock(); // TPM2.NET is received by the main loop
+  #endif
+  realtimeFrameStart(protocol);
+  if (last) realtimeFrameComplete();
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestUnlock();
+  #endif
+}
+
+// a universe of the current frame has been received
+// universe - index of the universe relative to e131Universe
+// count    - number of universes a complete frame consists of
+// sync     - E1.31 synchronization address of the packet (0 if none)
+static void realtimeFrameUniverse(uint8_t protocol, uint8_t universe, uint8_t count, uint16_t sync) {
+  const uint32_t bit = 1UL << universe;
+  if (frameUniverses & bit) realtimeFrameComplete(); // universe repeated, the previous frame misses packets: show it
+  realtimeFrameStart(protocol);
+  frameUniverses |= bit;
+  frameSyncAddress = sync;
+  // ArtSync only synchronizes Art-Net frames
+  const bool artSynced = protocol == RT_STATS_ARTNET && lastArtSync && millis() - lastArtSync < ARTSYNC_TIMEOUT;
+  const bool synchronized = (sync && sync != syncMissing) || artSynced;
+  if (!synchronized && frameUniverses == (1UL << count) - 1) realtimeFrameComplete();
+}
+
+/*
+ * E1.31 synchronization packets are sent to the multicast group of the synchronization universe (E1.31-2016: 9.3.1),
+ * ESPAsyncE131 only joins the groups of our data universes.
+ */
+typedef struct {
+  #ifdef ARDUINO_ARCH_ESP32
+  struct tcpip_api_call_data call; // must be first, see tcpip_api_call()
+  #endif
+  uint16_t leave, join;     // synchronization universes (0 = none)
+  uint32_t leaveIf, joinIf; // interface addresses
+} e131_sync_membership_t;
+
+static void updateE131SyncMembership(const e131_sync_membership_t &m)
+{
+  ip4_addr_t ifaddr;
+  ip4_addr_t group;
+  if (m.leave) {
+    ifaddr.addr = m.leaveIf;
+    group.addr  = uint32_t(IPAddress(239, 255, m.leave >> 8, m.leave & 0xFF));
+    igmp_leavegroup(&ifaddr, &group);
+  }
+  if (m.join) {
+    ifaddr.addr = m.joinIf;
+    group.addr  = uint32_t(IPAddress(239, 255, m.join >> 8, m.join & 0xFF));
+    igmp_joingroup(&ifaddr, &group);
+  }
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+// lwIP raw API calls must be made in the TCP/IP task on ESP32 (as AsyncUDP does)
+static err_t e131SyncMembershipCall(struct tcpip_api_call_data *call)
+{
+  updateE131SyncMembership(*(e131_sync_membership_t *)call);
+  return ERR_OK;
+}
+#endif
+
+// joins the multicast group of the synchronization universe used by the sender (called from handleNotifications())
+void handleE131SyncMulticast()
+{
+  static uint16_t joined = 0;
+  static uint32_t joinedIf = 0;
+  uint32_t ifAddr = uint32_t(Network.localIP());
+  uint16_t wanted = (e131Multicast && interfacesInited && ifAddr) ? syncUniverse : 0;
+  if (wanted >= e131Universe && wanted < e131Universe + E131_MAX_UNIVERSE_COUNT) wanted = 0; // joined by ESPAsyncE131
+  if (wanted == joined && (!wanted || ifAddr == joinedIf)) return;
+  e131_sync_membership_t m = {};
+  m.leave   = joined;
+  m.leaveIf = joinedIf;
+  m.join    = wanted;
+  m.joinIf  = ifAddr;
+  #ifdef ARDUINO_ARCH_ESP32
+  tcpip_api_call(e131SyncMembershipCall, &m.call); // waits until done
+  #else
+  updateE131SyncMembership(m); // lwIP runs in the loop context on ESP8266
+  #endif
+  joined = wanted;
+  joinedIf = ifAddr;
+}
+
+/*
+ * DMX layout of the pixel per LED modes (DMX_MODE_MULTIPLE_*)
+ * The first universe starts at DMXAddress (after the dimmer channel in DMX_MODE_MULTIPLE_DRGB),
+ * the following ones at their first channel.
+ */
+static inline bool dmxMultipleMode() {
+  return DMXMode == DMX_MODE_MULTIPLE_RGB || DMXMode == DMX_MODE_MULTIPLE_DRGB || DMXMode == DMX_MODE_MULTIPLE_RGBW;
+}
+
+// LEDs in universe (relative to e131Universe)
+static uint16_t dmxLedsInUniverse(uint8_t universe) {
+  const bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
+  if (universe) return is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+  const uint16_t dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // legacy DMX start address 0
+  return (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - (DMXMode == DMX_MODE_MULTIPLE_DRGB ? 1 : 0)) / (is4Chan ? 4 : 3);
+}
+
+// realtime pixels the configured input carries: the strip length, rounded up to whole universes if every LED
+// has its own DMX channels (so segments running the "Realtime" effect get complete universes)
+uint16_t realtimeInputLength() {
+  const uint16_t len = strip.getLengthTotal();
+  if (!dmxMultipleMode()) return len;
+  const uint16_t first = dmxLedsInUniverse(0), rest = dmxLedsInUniverse(1);
+  if (len <= first) return first;
+  const uint8_t universes = MIN(1 + (len - first + rest - 1) / rest, E131_MAX_UNIVERSE_COUNT);
+  return MAX(len, first + (universes - 1) * rest);
+}
+
+// realtime input index of a pixel of universe (relative to e131Universe) as E1.31/Art-Net write it,
+// for input without universes (DDP, Hyperion, ...) universes are steps of 256 pixels; -1 if there is none
+int realtimeInputIndex(uint8_t universe, uint8_t pixel) {
+  int start = universe * 256;
+  if (realtimeMode == REALTIME_MODE_E131 || realtimeMode == REALTIME_MODE_ARTNET) {
+    if (dmxMultipleMode()) {
+      if (universe >= E131_MAX_UNIVERSE_COUNT) return -1;
+      start = universe ? dmxLedsInUniverse(0) + (universe - 1) * dmxLedsInUniverse(1) : 0;
+    } else {
+      if (universe) return -1; // all other modes use one universe
+      start = 0;
+    }
+  }
+  return start + pixel + arlsOffset;
+}
+
+/*
+ * Realtime input statistics
+ * Counted per protocol in realtimeStats[] (and per universe for E1.31/Art-Net in realtimeUniverseStats[]),
+ * reported in /json/info ("rtstats") and in binary form by /rtstats.
+ */
+
+// counts a received packet and the time since the previous one
+void realtimeStatsPacket(uint8_t protocol) {
+  realtime_stats_t &st = realtimeStats[protocol];
+  unsigned long now = micros();
+  if (st.packets) {
+    uint32_t d = (now - st.lastPacket) >> 8; // 256 us units
+    uint8_t bin = d ? 32 - __builtin_clz(d) : 0;
+    st.jitter[MIN(bin, RT_STATS_JITTER_BINS-1)]++;
+  }
+  st.lastPacket = now;
+  st.packets++;
+}
+
+// counts a shown frame and the time since its first packet arrived
+void realtimeStatsFrame(uint8_t protocol, unsigned long frameStartUs) {
+  realtime_stats_t &st = realtimeStats[protocol];
+  uint32_t latency = micros() - frameStartUs;
+  st.latencyAvg = st.frames ? st.latencyAvg + ((int32_t)(latency - st.latencyAvg) >> 4) : latency; // average over ~16 frames
+  if (latency > st.latencyMax) st.latencyMax = latency;
+  st.frames++;
+}
+
+void resetRealtimeStats() {
+  memset(realtimeStats, 0, sizeof(realtimeStats));
+  memset(realtimeUniverseStats, 0, sizeof(realtimeUniverseStats));
+}
+
+// compares the sequence number of a packet with the previous one of the same stream
+// sequence numbers run from first to first+count-1 and wrap around
+// returns the number of skipped sequence numbers
+static uint8_t realtimeStatsSequence(realtime_stats_t &st, uint8_t last, uint8_t seq, uint8_t first, uint16_t count) {
+  uint16_t diff = ((seq - first) - (last - first) + count) % count;
+  if (diff == 0) { st.duplicates++; return 0; }
+  if (diff > count/2) { st.outOfOrder++; return 0; }
+  st.gaps += diff - 1;
+  return diff - 1;
+}
+
+// DDP timecodes are the middle 32 bits of an NTP timestamp (16 bit seconds, 16 bit fraction)
+// returns the milliseconds until the timecode is due, 0 if it is past, too far ahead or our clock is not ms accurate
+static uint16_t ddpTimecodeDelay(uint32_t timecode) {
+  if (toki.getTimeSource() < TOKI_TS_UDP_NTP) return 0;
+  Toki::Time t = toki.getTime();
+  uint32_t now = ((t.sec + YEARS_70) << 16) | (((uint32_t)t.ms << 16) / 1000);
+  int32_t ms = ((int64_t)(int32_t)(timecode - now) * 1000) >> 16;
+  return (ms > 0 && ms <= DDP_TIMECODE_MAX_DELAY) ? ms : 0;
+}
+
+// answers DDP status and config queries (used by senders for discovery) with a JSON reply
+static void handleDDPQuery(e131_packet_t* p, IPAddress clientIP) {
+  byte reply[DDP_HEADER_LEN + 224];
+  char *json = (char*)reply + DDP_HEADER_LEN;
+  const size_t jsonSize = sizeof(reply) - DDP_HEADER_LEN;
+  const bool isRGBW = strip.hasRGBWBus();
+  int len;
+
+  if (p->destination == DDP_ID_STATUS) {
+    len = snprintf_P(json, jsonSize, PSTR("{\"status\":{\"man\":\"WLED\",\"mod\":\"%s\",\"ver\":\"%s\",\"mac\":\"%s\",\"push\":true,\"ntp\":%s}}"),
+      serverDescription, versionString, escapedMac.c_str(), toki.getTimeSource() >= TOKI_TS_UDP_NTP ? "true" : "false");
+  } else if (p->destination == DDP_ID_CONFIG) {
+    len = snprintf_P(json, jsonSize, PSTR("{\"config\":{\"ip\":\"%s\",\"nm\":\"%s\",\"gw\":\"%s\",\"ports\":[{\"port\":0,\"ts\":0,\"l\":%u,\"ss\":0,\"ch\":%u}]}}"),
+      Network.localIP().toString().c_str(), Network.subnetMask().toString().c_str(), Network.gatewayIP().toString().c_str(),
+      strip.getLengthTotal(), isRGBW ? 4 : 3);
+  } else return; // only status and config can be queried
+  if (len < 0 || len >= (int)jsonSize) return;
+
+  reply[0] = DDP_VERSION_1 | DDP_REPLY_FLAG | DDP_PUSH_FLAG;
+  reply[1] = p->sequenceNum;
+  reply[2] = isRGBW ? DDP_TYPE_RGBW32 : DDP_TYPE_RGB24; // our pixel format
+  reply[3] = p->destination;
+  memset(reply + 4, 0, 4); // offset
+  reply[8] = len >> 8;
+  reply[9] = len & 0xFF;
+
+  notifierUdp.beginPacket(clientIP, DDP_DEFAULT_PORT);
+  notifierUdp.write(reply, DDP_HEADER_LEN + len);
+  notifierUdp.endPacket();
+}
+
 //DDP protocol support, called by handleE131Packet
 //handles RGB data only
-void handleDDPPacket(e131_packet_t* p) {
+void handleDDPPacket(e131_packet_t* p, IPAddress clientIP) {
+  if (p->flags & DDP_QUERY_FLAG) {
+    handleDDPQuery(p, clientIP);
+    return;
+  }
+  if (p->destination >= DDP_ID_CONTROL && p->destination < 255) return; // control/config/status writes are not supported
+
+
+  static uint8_t ddpLastSeq = 0;
   int lastPushSeq = e131LastSequenceNumber[0];
 
+  realtimeStatsPacket(RT_STATS_DDP);
+  uint8_t seq = p->sequenceNum & 0xF; // 1..15, 0 = not used
+  if (seq && ddpLastSeq) realtimeStatsSequence(realtimeStats[RT_STATS_DDP], ddpLastSeq, seq, 1, 15);
+  if (seq) ddpLastSeq = seq;
+
   //reject late packets belonging to previous frame (assuming 4 packets max. before push)
   if (e131SkipOutOfSequence && lastPushSeq) {
     int sn = p->sequenceNum & 0xF;
     if (sn) {
       if (lastPushSeq > 5) {
-        if (sn > (lastPushSeq -5) && sn < lastPushSeq) return;
+        if (sn > (lastPushSeq -5) && sn < lastPushSeq) { realtimeStats[RT_STATS_DDP].dropped++; return; }
       } else {
-        if (sn > (10 + lastPushSeq) || sn < lastPushSeq) return;
+        if (sn > (10 + lastPushSeq) || sn < lastPushSeq) { realtimeStats[RT_STATS_DDP].dropped++; return; }
       }
     }
   }
@@ -32,30 +347,39 @@ void handleDDPPacket(e131_packet_t* p) {
   uint16_t stop = start + htons(p->dataLen) / ddpChannelsPerLed;
   uint8_t* data = p->data;
   uint16_t c = 0;
-  if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
+  uint16_t delayMs = 0;
+  if (p->flags & DDP_TIMECODE_FLAG) { // packet has a timecode, data starts 4 bytes later
+    c = 4;
+    delayMs = ddpTimecodeDelay(((uint32_t)data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3]);
+  }
 
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
-  if (!realtimeOverride || (realtimeMode && useMainSegmentOnly)) {
-    for (uint16_t i = start; i < stop; i++) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-      c += ddpChannelsPerLed;
-    }
+  if ((!realtimeOverride || (realtimeMode && useMainSegmentOnly)) && stop > start) {
+    setRealtimePixels(start, data + c, stop - start, ddpChannelsPerLed);
   }
 
+  if (stop > start) {
+    realtimeFrameStart(RT_STATS_DDP);
+    frameDDPChannels += stop - start;
+  }
   bool push = p->flags & DDP_PUSH_FLAG;
   if (push) {
-    e131NewData = true;
+    ddpUsesPush = true;
+    if (framePending) realtimeFrameComplete(delayMs); // a PUSH without new data since the last one has nothing to show
     byte sn = p->sequenceNum & 0xF;
     if (sn) e131LastSequenceNumber[0] = sn;
+  } else if (!ddpUsesPush && frameDDPChannels >= strip.getLengthTotal()) {
+    realtimeFrameComplete(); // sender without PUSH: the whole strip has been received
   }
 }
 
 //E1.31 and Art-Net protocol support
-void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
+static void handleE131Data(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
-  uint16_t uni = 0, dmxChannels = 0;
+  uint16_t uni = 0, dmxChannels = 0, syncAddress = 0;
   uint8_t* e131_data = nullptr;
+  uint8_t frameUniverseCount = 1; // universes per frame
   uint8_t seq = 0, mde = REALTIME_MODE_E131;
 
   if (protocol == P_ARTNET)
@@ -64,12 +388,26 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      if (clientIP == Network.localIP()) return; // our own ArtSync (Art-Net output), see realtimeBroadcastSync()
+      // only the controller sending our ArtDmx may synchronize us (Art-Net 4: ArtSync from other IPs is ignored)
+      if (realtimeMode != REALTIME_MODE_ARTNET || clientIP != realtimeIP) return;
+      lastArtSync = millis();
+      if (framePending && frameProtocol == RT_STATS_ARTNET) realtimeFrameComplete();
+      return;
+    }
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    if (htonl(p->root_vector) == E131_VECTOR_ROOT_EXTENDED) { // synchronization packet
+      uint16_t sync = (p->raw[E131_SYNC_ADDRESS] << 8) | p->raw[E131_SYNC_ADDRESS+1];
+      if (sync == syncMissing) syncMissing = 0; // sync packets arrive (again), hold frames for them
+      if (framePending && sync == frameSyncAddress) realtimeFrameComplete();
+      return;
+    }
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
     dmxChannels = htons(p->property_value_count) - 1;
@@ -78,6 +416,8 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     uni = htons(p->universe);
     e131_data = p->property_values;
     seq = p->sequence_number;
+    syncAddress = htons(p->reserved); // synchronization address (E1.31-2016: 6.2.4.1)
+    if (syncAddress) syncUniverse = syncAddress;
     if (e131Priority != 0) {
       if (p->priority < e131Priority ) return;
       // track highest priority & skip all lower priorities
@@ -86,7 +426,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     }
   } else { //DDP
     realtimeIP = clientIP;
-    handleDDPPacket(p);
+    handleDDPPacket(p, clientIP);
     return;
   }
 
@@ -104,8 +444,20 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
   uint8_t previousUniverses = uni - e131Universe;
 
+  const uint8_t statsProtocol = (protocol == P_ARTNET) ? RT_STATS_ARTNET : RT_STATS_E131;
+  realtime_universe_stats_t &universeStats = realtimeUniverseStats[previousUniverses];
+  realtimeStatsPacket(statsProtocol);
+  if (universeStats.packets) {
+    if (protocol != P_ARTNET) // E1.31 sequence 0..255
+      universeStats.gaps += realtimeStatsSequence(realtimeStats[statsProtocol], e131LastSequenceNumber[previousUniverses], seq, 0, 256);
+    else if (seq && e131LastSequenceNumber[previousUniverses]) // Art-Net sequence 1..255, 0 = disabled
+      universeStats.gaps += realtimeStatsSequence(realtimeStats[statsProtocol], e131LastSequenceNumber[previousUniverses], seq, 1, 255);
+  }
+  universeStats.packets++;
+
   if (e131SkipOutOfSequence)
     if (seq < e131LastSequenceNumber[previousUniverses] && seq > 20 && e131LastSequenceNumber[previousUniverses] < 250){
+      realtimeStats[statsProtocol].dropped++;
       DEBUG_PRINT(F("skipping E1.31 frame (last seq="));
       DEBUG_PRINT(e131LastSequenceNumber[previousUniverses]);
       DEBUG_PRINT(F(", current seq="));
@@ -118,9 +470,10 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
   e131LastSequenceNumber[previousUniverses] = seq;
 
   // update status info
+  if (clientIP != realtimeIP || protocol != P_ARTNET) lastArtSync = 0; // ArtSync of a previous source does not apply
   realtimeIP = clientIP;
   byte wChannel = 0;
-  uint16_t totalLen = strip.getLengthTotal();
+  uint16_t totalLen = strip.hasRealtimeSegments() ? strip.getRealtimeInputLength() : strip.getLengthTotal();
   uint16_t availDMXLen = 0;
   uint16_t dataOffset = DMXAddress;
 
@@ -265,9 +618,13 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       {
         bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
         const uint16_t dmxChannelsPerLed = is4Chan ? 4 : 3;
-        const uint16_t ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+        const uint16_t ledsPerUniverse = dmxLedsInUniverse(1);
         uint8_t stripBrightness = bri;
         uint16_t previousLeds, dmxOffset, ledsTotal;
+        const uint16_t ledsInFirstUniverse = dmxLedsInUniverse(0);
+        if (totalLen > ledsInFirstUniverse) {
+          frameUniverseCount = min(1 + (totalLen - ledsInFirstUniverse + ledsPerUniverse - 1) / ledsPerUniverse, E131_MAX_UNIVERSE_COUNT);
+        }
 
         if (previousUniverses == 0) {
           if (availDMXLen < 1) return;
@@ -283,8 +640,6 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
         } else {
           // All subsequent universes start at the first channel.
           dmxOffset = (protocol == P_ARTNET) ? 0 : 1;
-          const uint16_t dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
-          uint16_t ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
           previousLeds = ledsInFirstUniverse + (previousUniverses - 1) * ledsPerUniverse;
           ledsTotal = previousLeds + (dmxChannels / dmxChannelsPerLed);
         }
@@ -308,16 +663,8 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
           }
         }
 
-        if (!is4Chan) {
-          for (uint16_t i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], 0);
-            dmxOffset+=3;
-          }
-        } else {
-          for (uint16_t i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], e131_data[dmxOffset+3]);
-            dmxOffset+=4;
-          }
+        if (ledsTotal > previousLeds) {
+          setRealtimePixels(previousLeds, e131_data + dmxOffset, ledsTotal - previousLeds, dmxChannelsPerLed);
         }
         break;
       }
@@ -327,7 +674,18 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       break;
   }
 
-  e131NewData = true;
+  realtimeFrameUniverse(statsProtocol, previousUniverses, frameUniverseCount, syncAddress);
+}
+
+// called by the AsyncUDP task (E1.31, Art-Net, DDP)
+void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestLock(); // Hyperion frames are assembled in realtimeIngestTask()
+  #endif
+  handleE131Data(p, clientIP, protocol);
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestUnlock();
+  #endif
 }
 
 void handleArtnetPollReply(IPAddress ipAddress) {
@@ -82,7 +82,33 @@ void initDMX();
 void handleDMX();
 
 //e131.cpp
+typedef struct RealtimeStats {
+  uint32_t packets;      // packets received
+  uint32_t dropped;      // packets dropped as out of sequence (e131SkipOutOfSequence)
+  uint32_t gaps;         // sequence numbers skipped, i.e. packets lost on the way
+  uint32_t duplicates;   // packets repeating the previous sequence number
+  uint32_t outOfOrder;   // packets older than the previous one
+  uint32_t frames;       // frames shown
+  uint32_t latencyAvg;   // moving average of the time from the first packet of a frame until it is shown (us)
+  uint32_t latencyMax;   // longest of those times (us)
+  uint32_t jitter[RT_STATS_JITTER_BINS]; // histogram of the times between packets
+  uint32_t lastPacket;   // micros() at the previous packet
+} realtime_stats_t;
+
+typedef struct RealtimeUniverseStats {
+  uint32_t packets;      // packets received for this universe (E1.31 and Art-Net)
+  uint32_t gaps;         // sequence numbers skipped
+} realtime_universe_stats_t;
+
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
+bool realtimeFrameReady();
+void handleE131SyncMulticast();
+uint16_t realtimeInputLength();
+int realtimeInputIndex(uint8_t universe, uint8_t pixel);
+void realtimeFramePacket(uint8_t protocol, bool last = true);
+void realtimeStatsPacket(uint8_t protocol);
+void realtimeStatsFrame(uint8_t protocol, unsigned long frameStartUs);
+void resetRealtimeStats();
 void handleArtnetPollReply(IPAddress ipAddress);
 void prepareArtnetPollReply(ArtPollReply* reply);
 void sendArtnetPollReply(ArtPollReply* reply, IPAddress ipAddress, uint16_t portAddress);
@@ -228,11 +254,21 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply=tru
 
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri=255, bool isRGBW=false);
+byte *realtimeBroadcastPacket(uint8_t type, bool isRGBW);
+uint8_t realtimeBroadcast(uint8_t type, const IPAddress *clients, uint8_t numClients, uint16_t universe, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW, byte *packet);
+void realtimeBroadcastSync(const IPAddress *clients, uint8_t numClients);
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(uint16_t i, const uint8_t* data, uint16_t count, uint8_t channels);
+#ifdef WLED_REALTIME_TASK
+void startRealtimeTask();
+void realtimeIngestLock();
+void realtimeIngestUnlock();
+bool realtimeFrameStoreActive();
+void realtimeFramePublish();
+#endif
 void refreshNodeList();
 void sendSysInfoUDP();
 
@@ -212,6 +212,7 @@ bool deserializeSegment(JsonObject elem, byte it, byte presetId)
   seg.transpose  = elem[F("tp")] | seg.transpose;
   if (seg.is2D() && seg.map1D2D == M12_pArc && (reverse != seg.reverse || reverse_y != seg.reverse_y || mirror != seg.mirror || mirror_y != seg.mirror_y)) seg.fill(BLACK); // clear entire segment (in case of Arc 1D to 2D expansion)
   #endif
+  seg.markRenderDirty(); // mapping and options are set directly
 
   byte fx = seg.mode;
   byte last = strip.getModeCount();
@@ -261,6 +262,7 @@ bool deserializeSegment(JsonObject elem, byte it, byte presetId)
       seg.freeze = true;
       seg.fill(BLACK);
     }
+    seg.updateRenderContext(); // once for all LEDs set below (mapping was changed directly)
 
     uint16_t start = 0, stop = 0;
     byte set = 0; //0 nothing set, 1 start set, 2 range set
@@ -295,6 +297,7 @@ bool deserializeSegment(JsonObject elem, byte it, byte presetId)
       }
     }
     seg.map1D2D = oldMap1D2D; // restore mapping
+    seg.markRenderDirty();
     strip.trigger(); // force segment update
   }
   // send UDP/WS if segment options changed (except selection; will also deselect current preset)
@@ -719,6 +722,35 @@ void serializeInfo(JsonObject root)
 
   root[F("ndc")] = nodeListEnabled ? (int)Nodes.size() : -1;
 
+  // realtime input statistics of the protocols that received packets (see realtime_stats_t)
+  JsonObject rt_stats = root.createNestedObject(F("rtstats"));
+  const char *rtNames[RT_STATS_PROTOCOLS] = {"e131", "artnet", "ddp", "hyperion", "tpm2"};
+  for (uint8_t i = 0; i < RT_STATS_PROTOCOLS; i++) {
+    const realtime_stats_t &st = realtimeStats[i];
+    if (!st.packets) continue;
+    JsonObject rt_p = rt_stats.createNestedObject(rtNames[i]);
+    rt_p[F("pkt")]  = st.packets;
+    rt_p[F("drop")] = st.dropped;
+    rt_p[F("gap")]  = st.gaps;
+    rt_p[F("dup")]  = st.duplicates;
+    rt_p[F("ooo")]  = st.outOfOrder;
+    rt_p[F("frm")]  = st.frames;
+    rt_p[F("lat")]  = st.latencyAvg;
+    rt_p[F("latmax")] = st.latencyMax;
+    JsonArray rt_jit = rt_p.createNestedArray(F("jit"));
+    for (uint8_t j = 0; j < RT_STATS_JITTER_BINS; j++) rt_jit.add(st.jitter[j]);
+  }
+  if (realtimeStats[RT_STATS_E131].packets || realtimeStats[RT_STATS_ARTNET].packets) {
+    JsonArray rt_uni = rt_stats.createNestedArray(F("uni")); // [packets, gaps] per universe from e131Universe on
+    uint8_t unis = E131_MAX_UNIVERSE_COUNT;
+    while (unis && !realtimeUniverseStats[unis-1].packets) unis--; // up to the last universe received, missing ones in between are listed
+    for (uint8_t i = 0; i < unis; i++) {
+      JsonArray u = rt_uni.createNestedArray();
+      u.add(realtimeUniverseStats[i].packets);
+      u.add(realtimeUniverseStats[i].gaps);
+    }
+  }
+
   #ifdef ARDUINO_ARCH_ESP32
   #ifdef WLED_DEBUG
     wifi_info[F("txPower")] = (int) WiFi.getTxPower();
@@ -78,7 +78,7 @@ byte scaledBri(byte in)
 
 //applies global brightness
 void applyBri() {
-  if (!realtimeMode || !arlsForceMaxBri)
+  if (!realtimeMode || !arlsForceMaxBri || strip.hasRealtimeSegments())
   {
     strip.setBrightness(scaledBri(briT));
   }
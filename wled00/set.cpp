@@ -154,7 +154,22 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       // actual finalization is done in WLED::loop() (removing old busses and adding new)
       // this may happen even before this loop is finished so we do "doInitBusses" after the loop
       if (busConfigs[s] != nullptr) delete busConfigs[s];
-      busConfigs[s] = new BusConfig(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freqHz, useGlobalLedBuffer);
+      busConfigs[s] = new BusConfig(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freqHz);
+      // universe and additional destinations of network busses are not part of the form (cfg.json only),
+      // keep those of the existing bus with the same type and IP (busses may have been added, removed or reordered)
+      if ((type & 0x7F) >= TYPE_NET_DDP_RGB && (type & 0x7F) < 96) {
+        Bus *bus = nullptr;
+        for (uint8_t b = 0; b < busses.getNumBusses(); b++) {
+          Bus *old = busses.getBus(b);
+          uint8_t ip[5] = {0};
+          if (!old || old->getType() != (type & 0x7F) || old->getPins(ip) < 4 || memcmp(ip, pins, 4)) continue;
+          if (!bus || old->getStart() == start) bus = old; // prefer the one at the same start LED
+        }
+        if (bus) {
+          busConfigs[s]->universe = bus->getUniverse();
+          busConfigs[s]->numDest  = bus->getDestinations(busConfigs[s]->dest);
+        }
+      }
       busesChanged = true;
     }
     //doInitBusses = busesChanged; // we will do that below to ensure all input data is processed
@@ -806,6 +821,7 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
 
   pos = req.indexOf(F("MI=")); //Segment mirror
   if (pos > 0) selseg.mirror = req.charAt(pos+3) != '0';
+  selseg.markRenderDirty();
 
   pos = req.indexOf(F("SB=")); //Segment brightness/opacity
   if (pos > 0) {
@@ -50,15 +50,31 @@ typedef struct ip_addr ip4_addr_t;
 #define ARTNET_DEFAULT_PORT 6454
 #define DDP_DEFAULT_PORT    4048
 
+#define DDP_HEADER_LEN 10
+#define DDP_SYNCPACKET_LEN 10
+
+#define DDP_VERSION_1 0x40 // version bits of the flags
 #define DDP_PUSH_FLAG 0x01
+#define DDP_QUERY_FLAG 0x02
+#define DDP_REPLY_FLAG 0x04
 #define DDP_TIMECODE_FLAG 0x10
 
+#define DDP_ID_DISPLAY 1
+#define DDP_ID_CONTROL 246
+#define DDP_ID_CONFIG  250
+#define DDP_ID_STATUS  251
+
 #define DDP_TYPE_RGB24  0x0B // 00 001 011 (RGB , 8 bits per channel, 3 channels)
 #define DDP_TYPE_RGBW32 0x1B // 00 011 011 (RGBW, 8 bits per channel, 4 channels)
 
 #define ARTNET_OPCODE_OPDMX 0x5000
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
+
+// E1.31 synchronization packet (E1.31-2016: 6.3)
+#define E131_VECTOR_ROOT_EXTENDED 0x00000008
+#define E131_SYNC_ADDRESS 45
 
 #define P_E131   0
 #define P_ARTNET 1
@@ -142,7 +158,7 @@ typedef union {
     uint8_t data[1];
   } __attribute__((packed));
 
-  /*struct { //DDP Time code Header (unsupported)
+  /*struct { //DDP Time code Header (timeCode is read from data[0..3])
     uint8_t flags;
     uint8_t sequenceNum;
     uint8_t dataType;
@@ -208,6 +224,7 @@ class ESPAsyncE131 {
 	  static const uint8_t ART_ID[];
     static const uint32_t VECTOR_ROOT = 4;
     static const uint32_t VECTOR_FRAME = 2;
+    static const uint32_t VECTOR_FRAME_SYNC = 1;
     static const uint8_t VECTOR_DMP = 2;
 
     AsyncUDP        udp;        // AsyncUDP
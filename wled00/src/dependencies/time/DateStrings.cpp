@@ -11,6 +11,10 @@
 
 #if defined(__AVR__)
 #include <avr/pgmspace.h>
+#elif defined(WLED_NATIVE)
+// host build: the force-included Arduino.h stub provides these, but the name tables hold 64 bit pointers
+#undef pgm_read_word
+#define pgm_read_word(addr) (*(addr))
 #else
 // for compatiblity with Arduino Due and Teensy 3.0 and maybe others?
 #define PROGMEM
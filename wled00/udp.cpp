@@ -10,23 +10,56 @@
 #define UDP_IN_MAXSIZE 1472
 #define PRESUMED_NETWORK_DELAY 3 //how many ms could it take on avg to reach the receiver? This will be added to transmitted times
 
-void notify(byte callMode, bool followUp)
+// Hyperion/raw UDP and TPM2.NET payload format (udpRgbFormat)
+#define RAW_FORMAT_RGBW   0x01 // 4 channels per pixel instead of 3
+#define RAW_FORMAT_HEADER 0x02 // raw packets start with a header: flags, reserved, start pixel (16 bit, big endian)
+#define RAW_HEADER_LEN    4
+#define RAW_HEADER_PUSH   0x01 // header flag: last packet of the frame
+
+static uint8_t udpInBuffer[UDP_IN_MAXSIZE+1]; // packets received in handleNotifications(), +1 to terminate API requests
+
+#ifdef WLED_REALTIME_TASK
+#include <atomic>
+#include <lwip/sockets.h>
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+#include <lwip/priv/tcpip_priv.h> // tcpip_api_call()
+#endif
+
+// v2 sync notifier: only the segment fields that changed since the previous packet, with sequence numbers
+// 0: SYNC_V2_ID, 1: flags, 2: sequence, 3-40: bytes 1-38 of the v1 packet, 41: number of segment entries,
+// then per segment: id, SEG_DIFFERS_* mask and the record bytes of every group in the mask (see syncSegGroups[])
+#define SYNC_V2_ID         0x20 // first byte, ignored by receivers that only know v1
+#define SYNC_V2_HEADER     42
+#define SYNC_V2_SNAPSHOT   0x01 // all fields of every active segment
+#define SYNC_V2_REQUEST    0x02 // receiver missed a packet and asks the sender for a snapshot
+#define SYNC_V2_PACKETSIZE (SYNC_V2_HEADER+MAX_NUM_SEGMENTS*(UDP_SEG_SIZE+1))
+#define SYNC_MULTICAST_GROUP(g) IPAddress(239, 87, 76, 1+(g)) // v2 multicast group of sync group bit g
+
+// lockstep checkpoint (see WS2812FX::service()), sent by nodes in lockstep after each effect state checkpoint
+// 0: LOCKSTEP_ID, 1: sync groups, 2-5: checkpoint frame, 6-9: effect state hash, 10-13: frame all nodes restart
+// their effects at (0: none), 14-15: random seed, 16-17: frame time in ms (frame numbers of nodes with a
+// different frame time do not match, their packets are ignored)
+#define LOCKSTEP_ID         0x21
+#define LOCKSTEP_PACKETSIZE 18
+#define LOCKSTEP_RESYNC_MIN 5000 // ms between two resyncs requested by us
+
+// bytes of the segment record (see serializeSyncSegment()) sent for each SEG_DIFFERS_* group, in packet order
+static const struct { uint8_t mask, from, count; } syncSegGroups[] = {
+  {SEG_DIFFERS_BOUNDS, 1, 4}, {SEG_DIFFERS_BOUNDS, 32, 4},  // start, stop, startY, stopY
+  {SEG_DIFFERS_GSO,    5, 4},                               // grouping, spacing, offset
+  {SEG_DIFFERS_OPT,    9, 1}, {SEG_DIFFERS_OPT, 28, 1},     // options
+  {SEG_DIFFERS_BRI,   10, 1},                               // opacity
+  {SEG_DIFFERS_FX,    11, 4}, {SEG_DIFFERS_FX, 29, 3},      // mode, speed, intensity, palette, custom1-3, checks
+  {SEG_DIFFERS_COL,   15, 13},                              // colors, cct
+};
+
+static uint8_t syncSequence = 0;
+static byte   *syncBaseline = nullptr; // segment records as last sent, by segment id (id byte 255: not sent)
+
+// fills bytes 0-38 of a v1 sync packet: everything but the segments
+static void serializeSyncHeader(byte *udpOut, byte callMode, bool followUp)
 {
-  if (!udpConnected) return;
-  if (!syncGroups) return;
-  switch (callMode)
-  {
-    case CALL_MODE_INIT:          return;
-    case CALL_MODE_DIRECT_CHANGE: if (!notifyDirect) return; break;
-    case CALL_MODE_BUTTON:        if (!notifyButton) return; break;
-    case CALL_MODE_BUTTON_PRESET: if (!notifyButton) return; break;
-    case CALL_MODE_NIGHTLIGHT:    if (!notifyDirect) return; break;
-    case CALL_MODE_HUE:           if (!notifyHue)    return; break;
-    case CALL_MODE_PRESET_CYCLE:  if (!notifyDirect) return; break;
-    case CALL_MODE_ALEXA:         if (!notifyAlexa)  return; break;
-    default: return;
-  }
-  byte udpOut[WLEDPACKETSIZE];
   Segment& mainseg = strip.getMainSegment();
   udpOut[0] = 0; //0: wled notifier protocol 1: WARLS protocol
   udpOut[1] = callMode;
@@ -88,69 +121,223 @@ void notify(byte callMode, bool followUp)
   //0: byte 38 contains 0-255 value, 255: no valid CCT, 1-254: Kelvin value MSB
   udpOut[37] = strip.hasCCTBus() ? 0 : 255; //check this is 0 for the next value to be significant
   udpOut[38] = mainseg.cct;
+}
 
-  udpOut[39] = strip.getActiveSegmentsNum();
-  udpOut[40] = UDP_SEG_SIZE; //size of each loop iteration (one segment)
-  size_t s = 0, nsegs = strip.getSegmentsNum();
-  for (size_t i = 0; i < nsegs; i++) {
-    Segment &selseg = strip.getSegment(i);
-    if (!selseg.isActive()) continue;
-    uint16_t ofs = 41 + s*UDP_SEG_SIZE; //start of segment offset byte
-    udpOut[0 +ofs] = s;
-    udpOut[1 +ofs] = selseg.start >> 8;
-    udpOut[2 +ofs] = selseg.start & 0xFF;
-    udpOut[3 +ofs] = selseg.stop >> 8;
-    udpOut[4 +ofs] = selseg.stop & 0xFF;
-    udpOut[5 +ofs] = selseg.grouping;
-    udpOut[6 +ofs] = selseg.spacing;
-    udpOut[7 +ofs] = selseg.offset >> 8;
-    udpOut[8 +ofs] = selseg.offset & 0xFF;
-    udpOut[9 +ofs] = selseg.options & 0x8F; //only take into account selected, mirrored, on, reversed, reverse_y (for 2D); ignore freeze, reset, transitional
-    udpOut[10+ofs] = selseg.opacity;
-    udpOut[11+ofs] = selseg.mode;
-    udpOut[12+ofs] = selseg.speed;
-    udpOut[13+ofs] = selseg.intensity;
-    udpOut[14+ofs] = selseg.palette;
-    udpOut[15+ofs] = R(selseg.colors[0]);
-    udpOut[16+ofs] = G(selseg.colors[0]);
-    udpOut[17+ofs] = B(selseg.colors[0]);
-    udpOut[18+ofs] = W(selseg.colors[0]);
-    udpOut[19+ofs] = R(selseg.colors[1]);
-    udpOut[20+ofs] = G(selseg.colors[1]);
-    udpOut[21+ofs] = B(selseg.colors[1]);
-    udpOut[22+ofs] = W(selseg.colors[1]);
-    udpOut[23+ofs] = R(selseg.colors[2]);
-    udpOut[24+ofs] = G(selseg.colors[2]);
-    udpOut[25+ofs] = B(selseg.colors[2]);
-    udpOut[26+ofs] = W(selseg.colors[2]);
-    udpOut[27+ofs] = selseg.cct;
-    udpOut[28+ofs] = (selseg.options>>8) & 0xFF; //mirror_y, transpose, 2D mapping & sound
-    udpOut[29+ofs] = selseg.custom1;
-    udpOut[30+ofs] = selseg.custom2;
-    udpOut[31+ofs] = selseg.custom3 | (selseg.check1<<5) | (selseg.check2<<6) | (selseg.check3<<7);
-    udpOut[32+ofs] = selseg.startY >> 8;
-    udpOut[33+ofs] = selseg.startY & 0xFF;
-    udpOut[34+ofs] = selseg.stopY >> 8;
-    udpOut[35+ofs] = selseg.stopY & 0xFF;
-    ++s;
-  }
-
-  //uint16_t offs = SEG_OFFSET;
-  //next value to be added has index: udpOut[offs + 0]
+// fills the UDP_SEG_SIZE bytes describing a segment in sync packets
+static void serializeSyncSegment(byte *rec, uint8_t id, Segment &seg)
+{
+  rec[0]  = id;
+  rec[1]  = seg.start >> 8;
+  rec[2]  = seg.start & 0xFF;
+  rec[3]  = seg.stop >> 8;
+  rec[4]  = seg.stop & 0xFF;
+  rec[5]  = seg.grouping;
+  rec[6]  = seg.spacing;
+  rec[7]  = seg.offset >> 8;
+  rec[8]  = seg.offset & 0xFF;
+  rec[9]  = seg.options & 0x8F; //only take into account selected, mirrored, on, reversed, reverse_y (for 2D); ignore freeze, reset, transitional
+  rec[10] = seg.opacity;
+  rec[11] = seg.mode;
+  rec[12] = seg.speed;
+  rec[13] = seg.intensity;
+  rec[14] = seg.palette;
+  rec[15] = R(seg.colors[0]);
+  rec[16] = G(seg.colors[0]);
+  rec[17] = B(seg.colors[0]);
+  rec[18] = W(seg.colors[0]);
+  rec[19] = R(seg.colors[1]);
+  rec[20] = G(seg.colors[1]);
+  rec[21] = B(seg.colors[1]);
+  rec[22] = W(seg.colors[1]);
+  rec[23] = R(seg.colors[2]);
+  rec[24] = G(seg.colors[2]);
+  rec[25] = B(seg.colors[2]);
+  rec[26] = W(seg.colors[2]);
+  rec[27] = seg.cct;
+  rec[28] = (seg.options>>8) & 0xFF; //mirror_y, transpose, 2D mapping & sound
+  rec[29] = seg.custom1;
+  rec[30] = seg.custom2;
+  rec[31] = seg.custom3 | (seg.check1<<5) | (seg.check2<<6) | (seg.check3<<7);
+  rec[32] = seg.startY >> 8;
+  rec[33] = seg.startY & 0xFF;
+  rec[34] = seg.stopY >> 8;
+  rec[35] = seg.stopY & 0xFF;
+}
 
+// sends a sync packet to the broadcast address, or to the multicast group of each of our sync groups
+static void sendSyncPacket(const byte *udpOut, size_t len, bool multicast)
+{
+  if (multicast) {
+    for (uint8_t g = 0; g < 8; g++) {
+      if (!(syncGroups & (1 << g))) continue;
+      notifierUdp.beginPacket(SYNC_MULTICAST_GROUP(g), udpPort);
+      notifierUdp.write(udpOut, len);
+      notifierUdp.endPacket();
+    }
+    return;
+  }
   IPAddress broadcastIp;
   broadcastIp = ~uint32_t(Network.subnetMask()) | uint32_t(Network.gatewayIP());
 
   notifierUdp.beginPacket(broadcastIp, udpPort);
-  notifierUdp.write(udpOut, WLEDPACKETSIZE);
+  notifierUdp.write(udpOut, len);
   notifierUdp.endPacket();
+}
+
+// sends a v2 sync packet to all receivers, or a snapshot to the one given
+// only packets sent to all receivers advance the baseline the next delta is computed from
+static void sendSyncV2Packet(byte callMode, byte flags, const IPAddress *to = nullptr)
+{
+  byte udpOut[SYNC_V2_PACKETSIZE];
+  byte rec[UDP_SEG_SIZE];
+  byte header[39];
+  serializeSyncHeader(header, callMode, false);
+  udpOut[0] = SYNC_V2_ID;
+  udpOut[1] = flags;
+  udpOut[2] = syncSequence;
+  memcpy(udpOut + 3, header + 1, 38);
+
+  if (!syncBaseline) {
+    syncBaseline = (byte*) malloc(MAX_NUM_SEGMENTS * UDP_SEG_SIZE);
+    if (syncBaseline) memset(syncBaseline, 255, MAX_NUM_SEGMENTS * UDP_SEG_SIZE);
+  }
+  size_t len = SYNC_V2_HEADER;
+  uint8_t n = 0;
+  for (size_t i = 0; i < strip.getSegmentsNum() && i < MAX_NUM_SEGMENTS; i++) {
+    Segment &seg = strip.getSegment(i);
+    byte *base = (syncBaseline && !to) ? syncBaseline + i*UDP_SEG_SIZE : nullptr;
+    if (!seg.isActive()) {
+      if (base) base[0] = 255;
+      continue;
+    }
+    serializeSyncSegment(rec, i, seg);
+    // same grouping as Segment::differs(), compared against what the receivers got last
+    uint8_t mask = 0;
+    for (const auto &g : syncSegGroups) {
+      bool same = !(flags & SYNC_V2_SNAPSHOT) && syncBaseline && syncBaseline[i*UDP_SEG_SIZE] == i
+               && !memcmp(rec + g.from, syncBaseline + i*UDP_SEG_SIZE + g.from, g.count);
+      if (!same) mask |= g.mask;
+    }
+    if (base) memcpy(base, rec, UDP_SEG_SIZE);
+    if (!mask) continue;
+    udpOut[len++] = i;
+    udpOut[len++] = mask;
+    for (const auto &g : syncSegGroups) {
+      if (!(mask & g.mask)) continue;
+      memcpy(udpOut + len, rec + g.from, g.count);
+      len += g.count;
+    }
+    n++;
+  }
+  udpOut[41] = n;
+
+  if (to) {
+    notifierUdp.beginPacket(*to, udpPort);
+    notifierUdp.write(udpOut, len);
+    notifierUdp.endPacket();
+  } else {
+    sendSyncPacket(udpOut, len, syncMulticast);
+  }
+}
+
+// state changes made by callMode are sent to the other nodes
+static bool notifies(byte callMode)
+{
+  if (!udpConnected) return false;
+  if (!syncGroups) return false;
+  switch (callMode)
+  {
+    case CALL_MODE_INIT:          return false;
+    case CALL_MODE_DIRECT_CHANGE: return notifyDirect;
+    case CALL_MODE_BUTTON:        return notifyButton;
+    case CALL_MODE_BUTTON_PRESET: return notifyButton;
+    case CALL_MODE_NIGHTLIGHT:    return notifyDirect;
+    case CALL_MODE_HUE:           return notifyHue;
+    case CALL_MODE_PRESET_CYCLE:  return notifyDirect;
+    case CALL_MODE_ALEXA:         return notifyAlexa;
+    default: return false;
+  }
+}
+
+void notify(byte callMode, bool followUp)
+{
+  if (!notifies(callMode)) return;
+  if (syncDeltaPackets) {
+    if (!followUp) syncSequence++;
+    sendSyncV2Packet(callMode, followUp ? SYNC_V2_SNAPSHOT : 0); // retries carry the full state, they may reach receivers that missed the delta
+  } else {
+    byte udpOut[WLEDPACKETSIZE];
+    serializeSyncHeader(udpOut, callMode, followUp);
+    udpOut[39] = strip.getActiveSegmentsNum();
+    udpOut[40] = UDP_SEG_SIZE; //size of each loop iteration (one segment)
+    size_t s = 0, nsegs = strip.getSegmentsNum();
+    for (size_t i = 0; i < nsegs; i++) {
+      Segment &selseg = strip.getSegment(i);
+      if (!selseg.isActive()) continue;
+      serializeSyncSegment(udpOut + 41 + s*UDP_SEG_SIZE, s, selseg);
+      ++s;
+    }
+
+    //uint16_t offs = SEG_OFFSET;
+    //next value to be added has index: udpOut[offs + 0]
+
+    sendSyncPacket(udpOut, WLEDPACKETSIZE, false);
+  }
   notificationSentCallMode = callMode;
   notificationSentTime = millis();
   notificationCount = followUp ? notificationCount + 1 : 0;
 }
 
+#ifdef WLED_REALTIME_TASK
+static SemaphoreHandle_t rtIngestMutex = nullptr;
+static TaskHandle_t rtLoopTask = nullptr;      // the main loop (set by startRealtimeTask())
+static uint32_t rtLockTimeoutMs = 0;           // realtimeLock() requested by another task, under rtIngestMutex
+static byte     rtLockMode = REALTIME_MODE_INACTIVE;
+
+// serializes realtime frame assembly between the AsyncUDP task, realtimeIngestTask() and the main loop (recursive)
+void realtimeIngestLock() {
+  if (rtIngestMutex) xSemaphoreTakeRecursive(rtIngestMutex, portMAX_DELAY);
+}
+
+void realtimeIngestUnlock() {
+  if (rtIngestMutex) xSemaphoreGiveRecursive(rtIngestMutex);
+}
+
+// the strip belongs to the main loop, realtime input received by other tasks only goes to the frame store
+static inline bool realtimeInMainLoop() {
+  return !rtLoopTask || xTaskGetCurrentTaskHandle() == rtLoopTask;
+}
+
+// main loop: enters realtime mode for the last realtimeLock() of another task
+static void handleRealtimeLock() {
+  realtimeIngestLock();
+  byte md = rtLockMode;
+  uint32_t timeoutMs = rtLockTimeoutMs;
+  rtLockMode = REALTIME_MODE_INACTIVE;
+  realtimeIngestUnlock();
+  if (md) realtimeLock(timeoutMs, md);
+}
+#endif
+
 void realtimeLock(uint32_t timeoutMs, byte md)
 {
+  #ifdef WLED_REALTIME_TASK
+  if (!realtimeInMainLoop()) { // clearing the strip and setting brightness is up to the main loop
+    realtimeIngestLock();
+    rtLockTimeoutMs = timeoutMs;
+    rtLockMode = md;
+    realtimeIngestUnlock();
+    return;
+  }
+  #endif
+  if (strip.hasRealtimeSegments()) {
+    // only segments running the "Realtime" effect show the input, brightness and the other segments stay as they are
+    if (realtimeTimeout != UINT32_MAX) {
+      realtimeTimeout = (timeoutMs == 255001 || timeoutMs == 65000) ? UINT32_MAX : millis() + timeoutMs;
+    }
+    realtimeMode = md;
+    return;
+  }
   if (!realtimeMode && !realtimeOverride) {
     uint16_t stop, start;
     if (useMainSegmentOnly) {
@@ -181,19 +368,29 @@ void realtimeLock(uint32_t timeoutMs, byte md)
   }
   realtimeMode = md;
 
+  // main segment pixels are set outside service(), refresh its render context once per packet
+  if (useMainSegmentOnly) strip.getMainSegment().updateRenderContext();
+
   if (realtimeOverride) return;
   if (arlsForceMaxBri) strip.setBrightness(scaledBri(255), true);
   if (briT > 0 && md == REALTIME_MODE_GENERIC) strip.show();
 }
 
 void exitRealtime() {
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestLock();
+  rtLockMode = REALTIME_MODE_INACTIVE; // drop a realtimeLock() the main loop has not applied yet
+  realtimeIngestUnlock();
+  #endif
   if (!realtimeMode) return;
   if (realtimeOverride == REALTIME_OVERRIDE_ONCE) realtimeOverride = REALTIME_OVERRIDE_NONE;
   strip.setBrightness(scaledBri(bri), true);
   realtimeTimeout = 0; // cancel realtime mode immediately
   realtimeMode = REALTIME_MODE_INACTIVE; // inform UI immediately
   realtimeIP[0] = 0;
-  if (useMainSegmentOnly) { // unfreeze live segment again
+  if (strip.hasRealtimeSegments()) {
+    strip.clearRealtimeInput(); // realtime segments go dark (or let the segments below show with Overlay)
+  } else if (useMainSegmentOnly) { // unfreeze live segment again
     strip.getMainSegment().freeze = false;
   } else {
     strip.show(); // possible fix for #3589
@@ -212,6 +409,524 @@ void sendTPM2Ack() {
 }
 
 
+#ifdef WLED_REALTIME_TASK
+/*
+ * Realtime frame store (dual core ESP32)
+ * E1.31/Art-Net/DDP packets are received in the AsyncUDP task and Hyperion packets in realtimeIngestTask(),
+ * so their pixels must not be written to the strip while the main loop renders or shows it.
+ * Frames are assembled in a back buffer and handed to the main loop through a triple buffer: publishing and
+ * taking a frame is one atomic exchange, the receiving tasks never wait for the loop and the loop always shows
+ * the latest complete frame.
+ * Both receiving tasks (and the main loop for its own realtime packets and frame timeouts) assemble frames
+ * only while holding rtIngestMutex (realtimeIngestLock()), so the back buffer and the frame assembly state
+ * in e131.cpp have a single writer at a time.
+ * Buffers hold logical pixels (before ledmap) of the strip, the main segment or the realtime input of segments
+ * running the "Realtime" effect. They are (re)allocated by the main loop while realtime is active, pixels
+ * received by the tasks before that are dropped.
+ */
+#define RT_FRESH 0x80 // rtMiddle holds a frame that has not been shown
+
+#define RT_TARGET_STRIP    0 // whole strip
+#define RT_TARGET_MAINSEG  1 // main segment only (useMainSegmentOnly)
+#define RT_TARGET_SEGMENTS 2 // realtime input of the "Realtime" effect
+
+static uint32_t *rtBuffers[3] = {nullptr, nullptr, nullptr};
+static uint16_t  rtBufferLen = 0;
+static uint8_t   rtBack  = 0;                  // receiving side (under rtIngestMutex): frame being assembled
+static uint8_t   rtFront = 1;                  // main loop: frame last shown
+static std::atomic<uint8_t> rtMiddle(2);       // exchanged between the two
+static bool      rtStoreEnabled = false;       // changed by the main loop under rtIngestMutex
+static uint8_t   rtStoreTarget = RT_TARGET_STRIP; // RT_TARGET_* of the buffers (set with rtStoreEnabled)
+
+// realtime modes received outside the main loop
+static inline bool realtimeStoreMode() {
+  return realtimeMode == REALTIME_MODE_E131 || realtimeMode == REALTIME_MODE_ARTNET
+      || realtimeMode == REALTIME_MODE_DDP  || realtimeMode == REALTIME_MODE_HYPERION;
+}
+
+// where realtime pixels currently go
+static inline uint8_t realtimeTarget() {
+  if (strip.hasRealtimeSegments()) return RT_TARGET_SEGMENTS;
+  return useMainSegmentOnly ? RT_TARGET_MAINSEG : RT_TARGET_STRIP;
+}
+
+// back buffer of the frame being assembled, nullptr if there is none (caller holds rtIngestMutex)
+static uint32_t* realtimeStoreBuffer() {
+  if (!rtStoreEnabled || rtStoreTarget != realtimeTarget() || !realtimeStoreMode()) return nullptr;
+  return rtBuffers[rtBack];
+}
+
+// frames are assembled in the store rather than on the strip (caller holds rtIngestMutex)
+bool realtimeFrameStoreActive() {
+  return realtimeStoreBuffer() != nullptr;
+}
+
+// hands the assembled frame to the main loop (caller holds rtIngestMutex)
+void realtimeFramePublish() {
+  if (!realtimeStoreBuffer()) return;
+  uint8_t done = rtBack;
+  rtBack = rtMiddle.exchange(done | RT_FRESH) & 0x03;
+  // packets may update only part of the strip, so the next frame starts from this one
+  memcpy(rtBuffers[rtBack], rtBuffers[done], rtBufferLen * sizeof(uint32_t));
+}
+
+// main loop: writes the latest published frame to the strip, the main segment or the realtime input
+static void realtimeFrameApply() {
+  if (!rtStoreEnabled || !(rtMiddle.load() & RT_FRESH)) return;
+  rtFront = rtMiddle.exchange(rtFront) & 0x03;
+  const uint32_t *frame = rtBuffers[rtFront];
+  if (rtStoreTarget != realtimeTarget()) return; // target changed, handleRealtimeStore() reallocates
+  if (rtStoreTarget == RT_TARGET_SEGMENTS) {
+    strip.setRealtimeInput(0, frame, rtBufferLen);
+  } else if (rtStoreTarget == RT_TARGET_MAINSEG) {
+    Segment &seg = strip.getMainSegment();
+    uint16_t len = MIN(rtBufferLen, seg.length());
+    seg.updateRenderContext(); // once per frame, not per pixel
+    for (uint16_t i = 0; i < len; i++) seg.setPixelColor(i, frame[i]);
+  } else {
+    strip.setPixels(0, frame, rtBufferLen);
+  }
+}
+
+// main loop: allocates the store while realtime input is active and frees it afterwards
+static void handleRealtimeStore() {
+  static uint16_t failedLen = 0; // don't retry a failed allocation until the length changes
+  bool wanted = realtimeMode && realtimeStoreMode();
+  uint8_t target = realtimeTarget();
+  uint16_t len = (target == RT_TARGET_SEGMENTS) ? strip.getRealtimeInputLength() : strip.getLengthTotal();
+  if (rtStoreEnabled && (!wanted || len != rtBufferLen || target != rtStoreTarget)) {
+    realtimeIngestLock(); // wait until no frame is being assembled
+    rtStoreEnabled = false;
+    realtimeIngestUnlock();
+    free(rtBuffers[0]);
+    rtBuffers[0] = rtBuffers[1] = rtBuffers[2] = nullptr;
+    rtBufferLen = 0;
+  }
+  if (!wanted) failedLen = 0;
+  if (rtStoreEnabled || !wanted || !len || len == failedLen) return;
+  size_t size = 3 * len * sizeof(uint32_t);
+  #if defined(BOARD_HAS_PSRAM) && defined(WLED_USE_PSRAM)
+  if (psramFound()) rtBuffers[0] = (uint32_t*) ps_calloc(size, 1); else
+  #endif
+  rtBuffers[0] = (uint32_t*) calloc(size, 1);
+  if (!rtBuffers[0]) {
+    DEBUG_PRINTLN(F("!!! Not enough RAM for realtime frame store !!!"));
+    failedLen = len;
+    return;
+  }
+  rtBuffers[1] = rtBuffers[0] + len;
+  rtBuffers[2] = rtBuffers[1] + len;
+  realtimeIngestLock();
+  rtBufferLen = len;
+  rtBack = 0; rtFront = 1; rtMiddle = 2;
+  rtStoreTarget = target;
+  rtStoreEnabled = true;
+  realtimeIngestUnlock();
+}
+#endif
+
+// Hyperion / raw UDP: RGB or RGBW pixels (udpRgbFormat)
+// without header every packet is a frame starting at the first LED, with header a frame may be split
+// into several packets, each stating its start pixel and the last one flagged
+static void handleHyperionPacket(const uint8_t *data, size_t len, IPAddress clientIP)
+{
+  uint16_t start = 0;
+  bool last = true;
+  if (udpRgbFormat & RAW_FORMAT_HEADER) {
+    if (len < RAW_HEADER_LEN) return;
+    last  = data[0] & RAW_HEADER_PUSH;
+    start = (data[2] << 8) | data[3];
+    data += RAW_HEADER_LEN;
+    len  -= RAW_HEADER_LEN;
+  }
+  const uint8_t channels = (udpRgbFormat & RAW_FORMAT_RGBW) ? 4 : 3;
+
+  realtimeIP = clientIP;
+  DEBUG_PRINTLN(clientIP);
+  realtimeStatsPacket(RT_STATS_HYPERION);
+  realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
+  if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
+  setRealtimePixels(start, data, len / channels, channels);
+  #ifndef WLED_REALTIME_TASK
+  if (realtimeMode && useMainSegmentOnly) return; // the main segment is shown with the other segments
+  #endif
+  realtimeFramePacket(RT_STATS_HYPERION, last); // shown by the main loop
+}
+
+#ifdef WLED_REALTIME_TASK
+// receives Hyperion packets on udpRgbPort, independent of how busy the main loop is
+// the task owns the socket: it is (re)bound when the port changes and blocks in recvfrom() otherwise
+static void realtimeIngestTask(void *)
+{
+  static uint8_t buf[UDP_IN_MAXSIZE];
+  int sock = -1;
+  uint16_t port = 0;
+  for (;;) {
+    bool portValid = udpRgbPort && udpRgbPort != udpPort && udpRgbPort != ntpLocalPort;
+    if (sock >= 0 && (port != udpRgbPort || !portValid)) {
+      close(sock);
+      sock = -1;
+      udpRgbConnected = false;
+    }
+    if (sock < 0) {
+      if (!portValid || !(interfacesInited || apActive)) { vTaskDelay(pdMS_TO_TICKS(500)); continue; }
+      sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+      struct sockaddr_in addr = {};
+      addr.sin_family = AF_INET;
+      addr.sin_port = htons(udpRgbPort);
+      addr.sin_addr.s_addr = htonl(INADDR_ANY);
+      struct timeval tv = {0, 200000}; // wake up regularly to notice port changes
+      if (sock < 0 || bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0
+          || setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0) {
+        DEBUG_PRINTLN(F("Realtime task: can't open Hyperion port."));
+        if (sock >= 0) close(sock);
+        sock = -1;
+        vTaskDelay(pdMS_TO_TICKS(1000));
+        continue;
+      }
+      port = udpRgbPort;
+      udpRgbConnected = true;
+    }
+    struct sockaddr_in from;
+    socklen_t fromLen = sizeof(from);
+    int len = recvfrom(sock, buf, sizeof(buf), 0, (struct sockaddr *)&from, &fromLen);
+    if (len < 3 || !receiveDirect) continue; // timeout, too short or disabled
+    realtimeIngestLock();
+    handleHyperionPacket(buf, len, IPAddress(from.sin_addr.s_addr));
+    realtimeIngestUnlock();
+  }
+}
+
+void startRealtimeTask()
+{
+  static TaskHandle_t realtimeTask = nullptr;
+  if (realtimeTask) return;
+  rtIngestMutex = xSemaphoreCreateRecursiveMutex();
+  rtLoopTask = xTaskGetCurrentTaskHandle(); // called from setup()
+  // core 0 runs the network stack, the main loop runs on core 1
+  xTaskCreatePinnedToCore(realtimeIngestTask, "realtime", 3072, nullptr, 2, &realtimeTask, 0);
+}
+#endif
+
+// applies a v1 sync packet (v2 packets are expanded to one by handleSyncV2Packet())
+static void parseNotifyPacket(const byte *udpIn)
+{
+  //ignore notification if received within a second after sending a notification ourselves
+  if (millis() - notificationSentTime < 1000) return;
+  if (udpIn[1] > 199) return; //do not receive custom versions
+
+  //compatibilityVersionByte:
+  byte version = udpIn[11];
+
+  // if we are not part of any sync group ignore message
+  if (version < 9 || version > 199) {
+    // legacy senders are treated as if sending in sync group 1 only
+    if (!(receiveGroups & 0x01)) return;
+  } else if (!(receiveGroups & udpIn[36])) return;
+
+  bool someSel = (receiveNotificationBrightness || receiveNotificationColor || receiveNotificationEffects);
+
+  // set transition time before making any segment changes
+  if (version > 3) {
+    if (fadeTransition) {
+      jsonTransitionOnce = true;
+      strip.setTransition(((udpIn[17] << 0) & 0xFF) + ((udpIn[18] << 8) & 0xFF00));
+    }
+  }
+
+  //apply colors from notification to main segment, only if not syncing full segments
+  if ((receiveNotificationColor || !someSel) && (version < 11 || !receiveSegmentOptions)) {
+    // primary color, only apply white if intended (version > 0)
+    strip.setColor(0, RGBW32(udpIn[3], udpIn[4], udpIn[5], (version > 0) ? udpIn[10] : 0));
+    if (version > 1) {
+      strip.setColor(1, RGBW32(udpIn[12], udpIn[13], udpIn[14], udpIn[15])); // secondary color
+    }
+    if (version > 6) {
+      strip.setColor(2, RGBW32(udpIn[20], udpIn[21], udpIn[22], udpIn[23])); // tertiary color
+      if (version > 9 && version < 200 && udpIn[37] < 255) { // valid CCT/Kelvin value
+        uint16_t cct = udpIn[38];
+        if (udpIn[37] > 0) { //Kelvin
+          cct |= (udpIn[37] << 8);
+        }
+        strip.setCCT(cct);
+      }
+    }
+  }
+
+  bool timebaseUpdated = false;
+  //apply effects from notification
+  bool applyEffects = (receiveNotificationEffects || !someSel);
+  if (version < 200)
+  {
+    if (applyEffects && currentPlaylist >= 0) unloadPlaylist();
+    if (version > 10 && (receiveSegmentOptions || receiveSegmentBounds)) {
+      uint8_t numSrcSegs = udpIn[39];
+      for (size_t i = 0; i < numSrcSegs; i++) {
+        uint16_t ofs = 41 + i*udpIn[40]; //start of segment offset byte
+        uint8_t id = udpIn[0 +ofs];
+        if (id > strip.getSegmentsNum()) break;
+
+        Segment& selseg = strip.getSegment(id);
+        if (!selseg.isActive() || !selseg.isSelected()) continue; //do not apply to non selected segments
+
+        uint16_t startY = 0, start  = (udpIn[1+ofs] << 8 | udpIn[2+ofs]);
+        uint16_t stopY  = 1, stop   = (udpIn[3+ofs] << 8 | udpIn[4+ofs]);
+        uint16_t offset = (udpIn[7+ofs] << 8 | udpIn[8+ofs]);
+        if (!receiveSegmentOptions) {
+          selseg.setUp(start, stop, selseg.grouping, selseg.spacing, offset, startY, stopY);
+          continue;
+        }
+        //for (size_t j = 1; j<4; j++) selseg.setOption(j, (udpIn[9 +ofs] >> j) & 0x01); //only take into account mirrored, on, reversed; ignore selected
+        selseg.options = (selseg.options & 0x0071U) | (udpIn[9 +ofs] & 0x0E); // ignore selected, freeze, reset & transitional
+        selseg.markRenderDirty();
+        selseg.setOpacity(udpIn[10+ofs]);
+        if (applyEffects) {
+          strip.setMode(id,  udpIn[11+ofs]);
+          selseg.speed     = udpIn[12+ofs];
+          selseg.intensity = udpIn[13+ofs];
+          selseg.palette   = udpIn[14+ofs];
+        }
+        if (receiveNotificationColor || !someSel) {
+          selseg.setColor(0, RGBW32(udpIn[15+ofs],udpIn[16+ofs],udpIn[17+ofs],udpIn[18+ofs]));
+          selseg.setColor(1, RGBW32(udpIn[19+ofs],udpIn[20+ofs],udpIn[21+ofs],udpIn[22+ofs]));
+          selseg.setColor(2, RGBW32(udpIn[23+ofs],udpIn[24+ofs],udpIn[25+ofs],udpIn[26+ofs]));
+          selseg.setCCT(udpIn[27+ofs]);
+        }
+        if (version > 11) {
+          // when applying synced options ignore selected as it may be used as indicator of which segments to sync
+          // freeze, reset should never be synced
+          // LSB to MSB: select, reverse, on, mirror, freeze, reset, reverse_y, mirror_y, transpose, map1d2d (3), ssim (2), set (2)
+          selseg.options = (selseg.options & 0b0000000000110001U) | (udpIn[28+ofs]<<8) | (udpIn[9 +ofs] & 0b11001110U); // ignore selected, freeze, reset
+          selseg.markRenderDirty();
+          if (applyEffects) {
+            selseg.custom1 = udpIn[29+ofs];
+            selseg.custom2 = udpIn[30+ofs];
+            selseg.custom3 = udpIn[31+ofs] & 0x1F;
+            selseg.check1  = (udpIn[31+ofs]>>5) & 0x1;
+            selseg.check1  = (udpIn[31+ofs]>>6) & 0x1;
+            selseg.check1  = (udpIn[31+ofs]>>7) & 0x1;
+          }
+          startY = (udpIn[32+ofs] << 8 | udpIn[33+ofs]);
+          stopY  = (udpIn[34+ofs] << 8 | udpIn[35+ofs]);
+        }
+        if (receiveSegmentBounds) {
+          selseg.setUp(start, stop, udpIn[5+ofs], udpIn[6+ofs], offset, startY, stopY);
+        } else {
+          selseg.setUp(selseg.start, selseg.stop, udpIn[5+ofs], udpIn[6+ofs], selseg.offset, selseg.startY, selseg.stopY);
+        }
+      }
+      stateChanged = true;
+    }
+
+    // simple effect sync, applies to all selected segments
+    if (applyEffects && (version < 11 || !receiveSegmentOptions)) {
+      for (size_t i = 0; i < strip.getSegmentsNum(); i++) {
+        Segment& seg = strip.getSegment(i);
+        if (!seg.isActive() || !seg.isSelected()) continue;
+        seg.setMode(udpIn[8]);
+        seg.speed = udpIn[9];
+        if (version > 2) seg.intensity = udpIn[16];
+        if (version > 4) seg.setPalette(udpIn[19]);
+      }
+      stateChanged = true;
+    }
+
+    if (applyEffects && version > 5) {
+      uint32_t t = (udpIn[25] << 24) | (udpIn[26] << 16) | (udpIn[27] << 8) | (udpIn[28]);
+      t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
+      t -= millis();
+      strip.timebase = t;
+      timebaseUpdated = true;
+    }
+  }
+
+  //adjust system time, but only if sender is more accurate than self
+  if (version > 7 && version < 200)
+  {
+    Toki::Time tm;
+    tm.sec = (udpIn[30] << 24) | (udpIn[31] << 16) | (udpIn[32] << 8) | (udpIn[33]);
+    tm.ms = (udpIn[34] << 8) | (udpIn[35]);
+    if (udpIn[29] > toki.getTimeSource()) { //if sender's time source is more accurate
+      toki.adjust(tm, PRESUMED_NETWORK_DELAY); //adjust trivially for network delay
+      uint8_t ts = TOKI_TS_UDP;
+      if (udpIn[29] > 99) ts = TOKI_TS_UDP_NTP;
+      else if (udpIn[29] >= TOKI_TS_SEC) ts = TOKI_TS_UDP_SEC;
+      toki.setTime(tm, ts);
+    } else if (timebaseUpdated && toki.getTimeSource() > 99) { //if we both have good times, get a more accurate timebase
+      Toki::Time myTime = toki.getTime();
+      uint32_t diff = toki.msDifference(tm, myTime);
+      strip.timebase -= PRESUMED_NETWORK_DELAY; //no need to presume, use difference between NTP times at send and receive points
+      if (toki.isLater(tm, myTime)) {
+        strip.timebase += diff;
+      } else {
+        strip.timebase -= diff;
+      }
+    }
+  }
+
+  nightlightActive = udpIn[6];
+  if (nightlightActive) nightlightDelayMins = udpIn[7];
+
+  if (receiveNotificationBrightness || !someSel) bri = udpIn[2];
+  stateUpdated(CALL_MODE_NOTIFICATION);
+}
+
+// receives a v2 sync packet: answers snapshot requests, requests a snapshot if packets were lost
+// and applies the state through parseNotifyPacket(), segment fields that are not in the packet keep our values
+static void handleSyncV2Packet(const byte *udpIn, size_t len, IPAddress sender)
+{
+  static IPAddress lastSender;
+  static uint8_t lastSeq = 0;
+  static unsigned long lastRequest = 0;
+  if (len < 3) return;
+  if (udpIn[1] & SYNC_V2_REQUEST) {
+    // only if we would notify of our last change, as notify() does
+    if (syncDeltaPackets && notifies(notificationSentCallMode)) sendSyncV2Packet(notificationSentCallMode, SYNC_V2_SNAPSHOT, &sender);
+    return;
+  }
+  if (len < SYNC_V2_HEADER || realtimeMode || !receiveNotifications) return;
+  if (!(receiveGroups & udpIn[38])) return; // sync groups (v1 byte 36)
+
+  uint8_t seq = udpIn[2];
+  bool snapshot = udpIn[1] & SYNC_V2_SNAPSHOT;
+  bool inSequence = sender == lastSender && seq == (uint8_t)(lastSeq + 1);
+  if (!snapshot && sender == lastSender && seq == lastSeq) return; // duplicate, we are in more than one of its groups
+  if (!snapshot && !inSequence && millis() - lastRequest > 1000) {
+    // lost packet(s) or a new sender: fields that changed meanwhile are not in this delta
+    byte request[3] = {SYNC_V2_ID, SYNC_V2_REQUEST, seq};
+    notifierUdp.beginPacket(sender, udpPort);
+    notifierUdp.write(request, sizeof(request));
+    notifierUdp.endPacket();
+    lastRequest = millis();
+  }
+  lastSender = sender;
+  lastSeq = seq;
+
+  byte syncIn[WLEDPACKETSIZE];
+  syncIn[0] = 0;
+  memcpy(syncIn + 1, udpIn + 3, 38);
+  syncIn[40] = UDP_SEG_SIZE;
+  uint8_t n = 0;
+  size_t ofs = SYNC_V2_HEADER;
+  for (uint8_t i = 0; i < udpIn[41] && n < MAX_NUM_SEGMENTS && ofs + 2 <= len; i++) {
+    uint8_t id = udpIn[ofs], mask = udpIn[ofs+1];
+    size_t entryLen = 2;
+    for (const auto &g : syncSegGroups) if (mask & g.mask) entryLen += g.count;
+    if (ofs + entryLen > len) break; // truncated
+    byte *rec = syncIn + 41 + n*UDP_SEG_SIZE;
+    serializeSyncSegment(rec, id, strip.getSegment(id));
+    ofs += 2;
+    for (const auto &g : syncSegGroups) {
+      if (!(mask & g.mask)) continue;
+      memcpy(rec + g.from, udpIn + ofs, g.count);
+      ofs += g.count;
+    }
+    n++;
+  }
+  syncIn[39] = n;
+  parseNotifyPacket(syncIn);
+}
+
+// joins the multicast groups of our receive sync groups while v2 multicast is enabled
+// changes the sync multicast groups joined
+typedef struct {
+  #ifdef ARDUINO_ARCH_ESP32
+  struct tcpip_api_call_data call; // must be first, see tcpip_api_call()
+  #endif
+  uint8_t  leave, join;     // sync group bits
+  uint32_t leaveIf, joinIf; // interface addresses
+} sync_membership_t;
+
+static void updateSyncMemberships(const sync_membership_t &m)
+{
+  ip4_addr_t ifaddr;
+  ip4_addr_t group;
+  for (uint8_t g = 0; g < 8; g++) {
+    group.addr = uint32_t(SYNC_MULTICAST_GROUP(g));
+    if (m.leave & (1 << g)) { ifaddr.addr = m.leaveIf; igmp_leavegroup(&ifaddr, &group); }
+    if (m.join  & (1 << g)) { ifaddr.addr = m.joinIf;  igmp_joingroup(&ifaddr, &group); }
+  }
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+// lwIP raw API calls must be made in the TCP/IP task on ESP32 (as AsyncUDP does)
+static err_t syncMembershipsCall(struct tcpip_api_call_data *call)
+{
+  updateSyncMemberships(*(sync_membership_t *)call);
+  return ERR_OK;
+}
+#endif
+
+static void handleSyncMulticast()
+{
+  static uint8_t joined = 0;
+  static uint32_t joinedIf = 0;
+  uint32_t ifAddr = uint32_t(Network.localIP());
+  uint8_t wanted = (syncMulticast && udpConnected && ifAddr) ? receiveGroups : 0;
+  if (wanted == joined && (!wanted || ifAddr == joinedIf)) return;
+  sync_membership_t m = {};
+  m.leave   = joined;
+  m.leaveIf = joinedIf;
+  m.join    = wanted;
+  m.joinIf  = ifAddr;
+  #ifdef ARDUINO_ARCH_ESP32
+  tcpip_api_call(syncMembershipsCall, &m.call); // waits until done
+  #else
+  updateSyncMemberships(m); // lwIP runs in the loop context on ESP8266
+  #endif
+  joined = wanted;
+  joinedIf = ifAddr;
+}
+
+static inline void writeUint32BE(byte *p, uint32_t v) { p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v; }
+static inline uint32_t readUint32BE(const byte *p) { return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3]; }
+
+// sends our effect state checkpoints to the other lockstep nodes and, if one of them reported a different state
+// for the same frame, asks all of them to restart their effects one second from now
+static void handleLockstep()
+{
+  static uint32_t sentFrame = 0;
+  static uint32_t resyncFrame = 0;
+  static unsigned long lastResync = 0;
+  if (!udpConnected || !strip.isLockstepActive()) return;
+
+  if (strip.lockstepDiverged() && (!lastResync || millis() - lastResync > LOCKSTEP_RESYNC_MIN)) {
+    resyncFrame = strip.getLockstepFrame() + 1000 / strip.getFrameTime() + 1;
+    strip.lockstepResync(resyncFrame);
+    lastResync = millis();
+    sentFrame = 0; // send the resync frame right away
+  }
+  if ((int32_t)(strip.getLockstepFrame() - resyncFrame) >= 0) resyncFrame = 0;
+
+  uint32_t frame = strip.getLockstepCheckFrame();
+  if (!notifyDirect || !syncGroups || frame == sentFrame) return;
+  byte packet[LOCKSTEP_PACKETSIZE];
+  packet[0] = LOCKSTEP_ID;
+  packet[1] = syncGroups;
+  writeUint32BE(packet + 2, frame);
+  writeUint32BE(packet + 6, strip.getLockstepCheckHash());
+  writeUint32BE(packet + 10, resyncFrame);
+  packet[14] = strip.lockstepSeed >> 8;
+  packet[15] = strip.lockstepSeed & 0xFF;
+  packet[16] = strip.getFrameTime() >> 8;
+  packet[17] = strip.getFrameTime() & 0xFF;
+  sendSyncPacket(packet, sizeof(packet), syncMulticast);
+  sentFrame = frame;
+}
+
+// receives the checkpoint of another lockstep node
+static void handleLockstepPacket(const byte *udpIn, size_t len)
+{
+  if (len < LOCKSTEP_PACKETSIZE || !receiveNotifications || !(receiveGroups & udpIn[1]) || !strip.isLockstepActive()) return;
+  if (((udpIn[16] << 8) | udpIn[17]) != strip.getFrameTime()) return; // frames of another length
+  uint16_t seed = (udpIn[14] << 8) | udpIn[15];
+  if (seed != strip.lockstepSeed) strip.lockstepSeed = seed; // not in the checkpoint hash, adopted without a resync
+  uint32_t resyncFrame = readUint32BE(udpIn + 10);
+  if (resyncFrame) strip.lockstepResync(resyncFrame);
+  uint32_t hash = readUint32BE(udpIn + 6);
+  if (hash) strip.lockstepCheckpoint(readUint32BE(udpIn + 2), hash);
+}
+
 void handleNotifications()
 {
   IPAddress localIP;
@@ -221,15 +936,26 @@ void handleNotifications()
     notify(notificationSentCallMode,true);
   }
 
-  if (e131NewData && millis() - strip.getLastShow() > 15)
-  {
-    e131NewData = false;
-    strip.show();
+  strip.updateRealtimeSegments(realtimeInputLength());
+  #ifdef WLED_REALTIME_TASK
+  handleRealtimeLock();
+  handleRealtimeStore();
+  #endif
+  if (realtimeFrameReady()) { // one show() per complete realtime frame
+    #ifdef WLED_REALTIME_TASK
+    realtimeFrameApply();
+    #endif
+    if (strip.hasRealtimeSegments()) strip.trigger(); // the "Realtime" effect renders it with the next frame
+    else strip.show();
   }
 
   //unlock strip when realtime UDP times out
   if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
 
+  handleSyncMulticast();
+  handleE131SyncMulticast();
+  handleLockstep();
+
   //receive UDP notifications
   if (!udpConnected) return;
 
@@ -240,29 +966,19 @@ void handleNotifications()
     isSupp = true;
   }
 
-  //hyperion / raw RGB
+  //hyperion / raw RGB (received by realtimeIngestTask() if WLED_REALTIME_TASK)
+  #ifndef WLED_REALTIME_TASK
   if (!packetSize && udpRgbConnected) {
     packetSize = rgbUdp.parsePacket();
     if (packetSize) {
       if (!receiveDirect) return;
       if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return;
-      realtimeIP = rgbUdp.remoteIP();
-      DEBUG_PRINTLN(rgbUdp.remoteIP());
-      uint8_t lbuf[packetSize];
-      rgbUdp.read(lbuf, packetSize);
-      realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
-      if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
-      uint16_t id = 0;
-      uint16_t totalLen = strip.getLengthTotal();
-      for (size_t i = 0; i < packetSize -2; i += 3)
-      {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-        id++; if (id >= totalLen) break;
-      }
-      if (!(realtimeMode && useMainSegmentOnly)) strip.show();
+      rgbUdp.read(udpInBuffer, packetSize);
+      handleHyperionPacket(udpInBuffer, packetSize, rgbUdp.remoteIP());
       return;
     }
   }
+  #endif
 
   if (!(receiveNotifications || receiveDirect)) return;
 
@@ -271,7 +987,7 @@ void handleNotifications()
   if (!packetSize || packetSize > UDP_IN_MAXSIZE) return;
   if (!isSupp && notifierUdp.remoteIP() == localIP) return; //don't process broadcasts we send ourselves
 
-  uint8_t udpIn[packetSize +1];
+  uint8_t *udpIn = udpInBuffer;
   uint16_t len;
   if (isSupp) len = notifier2Udp.read(udpIn, packetSize);
   else        len =  notifierUdp.read(udpIn, packetSize);
@@ -308,164 +1024,20 @@ void handleNotifications()
   }
 
   //wled notifier, ignore if realtime packets active
-  if (udpIn[0] == 0 && !realtimeMode && receiveNotifications)
-  {
-    //ignore notification if received within a second after sending a notification ourselves
-    if (millis() - notificationSentTime < 1000) return;
-    if (udpIn[1] > 199) return; //do not receive custom versions
-
-    //compatibilityVersionByte:
-    byte version = udpIn[11];
-
-    // if we are not part of any sync group ignore message
-    if (version < 9 || version > 199) {
-      // legacy senders are treated as if sending in sync group 1 only
-      if (!(receiveGroups & 0x01)) return;
-    } else if (!(receiveGroups & udpIn[36])) return;
-
-    bool someSel = (receiveNotificationBrightness || receiveNotificationColor || receiveNotificationEffects);
-
-    // set transition time before making any segment changes
-    if (version > 3) {
-      if (fadeTransition) {
-        jsonTransitionOnce = true;
-        strip.setTransition(((udpIn[17] << 0) & 0xFF) + ((udpIn[18] << 8) & 0xFF00));
-      }
-    }
-
-    //apply colors from notification to main segment, only if not syncing full segments
-    if ((receiveNotificationColor || !someSel) && (version < 11 || !receiveSegmentOptions)) {
-      // primary color, only apply white if intended (version > 0)
-      strip.setColor(0, RGBW32(udpIn[3], udpIn[4], udpIn[5], (version > 0) ? udpIn[10] : 0));
-      if (version > 1) {
-        strip.setColor(1, RGBW32(udpIn[12], udpIn[13], udpIn[14], udpIn[15])); // secondary color
-      }
-      if (version > 6) {
-        strip.setColor(2, RGBW32(udpIn[20], udpIn[21], udpIn[22], udpIn[23])); // tertiary color
-        if (version > 9 && version < 200 && udpIn[37] < 255) { // valid CCT/Kelvin value
-          uint16_t cct = udpIn[38];
-          if (udpIn[37] > 0) { //Kelvin
-            cct |= (udpIn[37] << 8);
-          }
-          strip.setCCT(cct);
-        }
-      }
-    }
-
-    bool timebaseUpdated = false;
-    //apply effects from notification
-    bool applyEffects = (receiveNotificationEffects || !someSel);
-    if (version < 200)
-    {
-      if (applyEffects && currentPlaylist >= 0) unloadPlaylist();
-      if (version > 10 && (receiveSegmentOptions || receiveSegmentBounds)) {
-        uint8_t numSrcSegs = udpIn[39];
-        for (size_t i = 0; i < numSrcSegs; i++) {
-          uint16_t ofs = 41 + i*udpIn[40]; //start of segment offset byte
-          uint8_t id = udpIn[0 +ofs];
-          if (id > strip.getSegmentsNum()) break;
-
-          Segment& selseg = strip.getSegment(id);
-          if (!selseg.isActive() || !selseg.isSelected()) continue; //do not apply to non selected segments
-
-          uint16_t startY = 0, start  = (udpIn[1+ofs] << 8 | udpIn[2+ofs]);
-          uint16_t stopY  = 1, stop   = (udpIn[3+ofs] << 8 | udpIn[4+ofs]);
-          uint16_t offset = (udpIn[7+ofs] << 8 | udpIn[8+ofs]);
-          if (!receiveSegmentOptions) {
-            selseg.setUp(start, stop, selseg.grouping, selseg.spacing, offset, startY, stopY);
-            continue;
-          }
-          //for (size_t j = 1; j<4; j++) selseg.setOption(j, (udpIn[9 +ofs] >> j) & 0x01); //only take into account mirrored, on, reversed; ignore selected
-          selseg.options = (selseg.options & 0x0071U) | (udpIn[9 +ofs] & 0x0E); // ignore selected, freeze, reset & transitional
-          selseg.setOpacity(udpIn[10+ofs]);
-          if (applyEffects) {
-            strip.setMode(id,  udpIn[11+ofs]);
-            selseg.speed     = udpIn[12+ofs];
-            selseg.intensity = udpIn[13+ofs];
-            selseg.palette   = udpIn[14+ofs];
-          }
-          if (receiveNotificationColor || !someSel) {
-            selseg.setColor(0, RGBW32(udpIn[15+ofs],udpIn[16+ofs],udpIn[17+ofs],udpIn[18+ofs]));
-            selseg.setColor(1, RGBW32(udpIn[19+ofs],udpIn[20+ofs],udpIn[21+ofs],udpIn[22+ofs]));
-            selseg.setColor(2, RGBW32(udpIn[23+ofs],udpIn[24+ofs],udpIn[25+ofs],udpIn[26+ofs]));
-            selseg.setCCT(udpIn[27+ofs]);
-          }
-          if (version > 11) {
-            // when applying synced options ignore selected as it may be used as indicator of which segments to sync
-            // freeze, reset should never be synced
-            // LSB to MSB: select, reverse, on, mirror, freeze, reset, reverse_y, mirror_y, transpose, map1d2d (3), ssim (2), set (2)
-            selseg.options = (selseg.options & 0b0000000000110001U) | (udpIn[28+ofs]<<8) | (udpIn[9 +ofs] & 0b11001110U); // ignore selected, freeze, reset
-            if (applyEffects) {
-              selseg.custom1 = udpIn[29+ofs];
-              selseg.custom2 = udpIn[30+ofs];
-              selseg.custom3 = udpIn[31+ofs] & 0x1F;
-              selseg.check1  = (udpIn[31+ofs]>>5) & 0x1;
-              selseg.check1  = (udpIn[31+ofs]>>6) & 0x1;
-              selseg.check1  = (udpIn[31+ofs]>>7) & 0x1;
-            }
-            startY = (udpIn[32+ofs] << 8 | udpIn[33+ofs]);
-            stopY  = (udpIn[34+ofs] << 8 | udpIn[35+ofs]);
-          }
-          if (receiveSegmentBounds) {
-            selseg.setUp(start, stop, udpIn[5+ofs], udpIn[6+ofs], offset, startY, stopY);
-          } else {
-            selseg.setUp(selseg.start, selseg.stop, udpIn[5+ofs], udpIn[6+ofs], selseg.offset, selseg.startY, selseg.stopY);
-          }
-        }
-        stateChanged = true;
-      }
-
-      // simple effect sync, applies to all selected segments
-      if (applyEffects && (version < 11 || !receiveSegmentOptions)) {
-        for (size_t i = 0; i < strip.getSegmentsNum(); i++) {
-          Segment& seg = strip.getSegment(i);
-          if (!seg.isActive() || !seg.isSelected()) continue;
-          seg.setMode(udpIn[8]);
-          seg.speed = udpIn[9];
-          if (version > 2) seg.intensity = udpIn[16];
-          if (version > 4) seg.setPalette(udpIn[19]);
-        }
-        stateChanged = true;
-      }
-
-      if (applyEffects && version > 5) {
-        uint32_t t = (udpIn[25] << 24) | (udpIn[26] << 16) | (udpIn[27] << 8) | (udpIn[28]);
-        t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
-        t -= millis();
-        strip.timebase = t;
-        timebaseUpdated = true;
-      }
-    }
-
-    //adjust system time, but only if sender is more accurate than self
-    if (version > 7 && version < 200)
-    {
-      Toki::Time tm;
-      tm.sec = (udpIn[30] << 24) | (udpIn[31] << 16) | (udpIn[32] << 8) | (udpIn[33]);
-      tm.ms = (udpIn[34] << 8) | (udpIn[35]);
-      if (udpIn[29] > toki.getTimeSource()) { //if sender's time source is more accurate
-        toki.adjust(tm, PRESUMED_NETWORK_DELAY); //adjust trivially for network delay
-        uint8_t ts = TOKI_TS_UDP;
-        if (udpIn[29] > 99) ts = TOKI_TS_UDP_NTP;
-        else if (udpIn[29] >= TOKI_TS_SEC) ts = TOKI_TS_UDP_SEC;
-        toki.setTime(tm, ts);
-      } else if (timebaseUpdated && toki.getTimeSource() > 99) { //if we both have good times, get a more accurate timebase
-        Toki::Time myTime = toki.getTime();
-        uint32_t diff = toki.msDifference(tm, myTime);
-        strip.timebase -= PRESUMED_NETWORK_DELAY; //no need to presume, use difference between NTP times at send and receive points
-        if (toki.isLater(tm, myTime)) {
-          strip.timebase += diff;
-        } else {
-          strip.timebase -= diff;
-        }
-      }
-    }
+  if (udpIn[0] == 0 && !realtimeMode && receiveNotifications) {
+    parseNotifyPacket(udpIn);
+    return;
+  }
 
-    nightlightActive = udpIn[6];
-    if (nightlightActive) nightlightDelayMins = udpIn[7];
+  //v2 (delta) wled notifier
+  if (udpIn[0] == SYNC_V2_ID) {
+    handleSyncV2Packet(udpIn, len, isSupp ? notifier2Udp.remoteIP() : notifierUdp.remoteIP());
+    return;
+  }
 
-    if (receiveNotificationBrightness || !someSel) bri = udpIn[2];
-    stateUpdated(CALL_MODE_NOTIFICATION);
+  //lockstep effect state checkpoint
+  if (udpIn[0] == LOCKSTEP_ID) {
+    handleLockstepPacket(udpIn, len);
     return;
   }
 
@@ -474,8 +1046,8 @@ void handleNotifications()
   //TPM2.NET
   if (udpIn[0] == 0x9c)
   {
-    //WARNING: this code assumes that the final TMP2.NET payload is evenly distributed if using multiple packets (ie. frame size is constant)
-    //if the number of LEDs in your installation doesn't allow that, please include padding bytes at the end of the last packet
+    //frames split into multiple packets: all packets but the last must have the same payload size
+    //(the last one may be shorter), the size should be a multiple of the channels per pixel
     byte tpmType = udpIn[1];
     if (tpmType == 0xaa) { //TPM2.NET polling, expect answer
       sendTPM2Ack(); return;
@@ -483,30 +1055,22 @@ void handleNotifications()
     if (tpmType != 0xda) return; //return if notTPM2.NET data
 
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
+    realtimeStatsPacket(RT_STATS_TPM2NET);
     realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
     if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
 
-    tpmPacketCount++; //increment the packet count
-    if (tpmPacketCount == 1) tpmPayloadFrameSize = (udpIn[2] << 8) + udpIn[3]; //save frame size for the whole payload if this is the first packet
+    uint16_t frameSize = (udpIn[2] << 8) + udpIn[3]; //payload size of this packet
     byte packetNum = udpIn[4]; //starts with 1!
     byte numPackets = udpIn[5];
-
-    uint16_t id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
-    uint16_t totalLen = strip.getLengthTotal();
-    for (size_t i = 6; i < tpmPayloadFrameSize + 4U; i += 3)
-    {
-      if (id < totalLen)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        id++;
-      }
-      else break;
-    }
-    if (tpmPacketCount == numPackets) //reset packet count and show if all packets were received
-    {
-      tpmPacketCount = 0;
-      strip.show();
-    }
+    if (packetSize < 6 || frameSize > packetSize - 6 || !packetNum || packetNum > numPackets) return;
+    if (packetNum < numPackets) tpmPayloadFrameSize = frameSize; //remember the size of full packets for the last one
+    else if (packetNum > 1 && !tpmPayloadFrameSize) return; //no full packet seen yet, offset unknown
+
+    const uint8_t channels = (udpRgbFormat & RAW_FORMAT_RGBW) ? 4 : 3;
+    uint16_t id = (uint32_t)tpmPayloadFrameSize * (packetNum-1) / channels; //start LED
+    setRealtimePixels(id, udpIn + 6, frameSize / channels, channels);
+    if (realtimeMode && useMainSegmentOnly) return;
+    realtimeFramePacket(RT_STATS_TPM2NET, packetNum == numPackets); //shown once all packets were received
     return;
   }
 
@@ -526,7 +1090,6 @@ void handleNotifications()
     }
     if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
 
-    uint16_t totalLen = strip.getLengthTotal();
     if ((udpIn[0] == 1) && (packetSize > 5)) //warls - avoiding infinite "for" loop (unsigned underflow)    
     {
       for (size_t i = 2; i < packetSize -3; i += 4)
@@ -535,40 +1098,18 @@ void handleNotifications()
       }
     } else if (udpIn[0] == 2) //drgb
     {
-      uint16_t id = 0;
-      for (size_t i = 2; i < packetSize -2; i += 3)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-
-        id++; if (id >= totalLen) break;
-      }
-    } else if ((udpIn[0] == 3) && (packetSize > 5)) //drgbw - avoiding infinite "for" loop (unsigned underflow)
+      setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 3, 3);
+    } else if ((udpIn[0] == 3) && (packetSize > 5)) //drgbw
     {
-      uint16_t id = 0;
-      for (size_t i = 2; i < packetSize -3; i += 4)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-
-        id++; if (id >= totalLen) break;
-      }
-    } else if (udpIn[0] == 4) //dnrgb
+      setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 4, 4);
+    } else if ((udpIn[0] == 4) && (packetSize > 4)) //dnrgb
     {
       uint16_t id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2; i += 3)
-      {
-        if (id >= totalLen) break;
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        id++;
-      }
-    } else if (udpIn[0] == 5) //dnrgbw
+      setRealtimePixels(id, udpIn + 4, (packetSize - 4) / 3, 3);
+    } else if ((udpIn[0] == 5) && (packetSize > 4)) //dnrgbw
     {
       uint16_t id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2; i += 4)
-      {
-        if (id >= totalLen) break;
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        id++;
-      }
+      setRealtimePixels(id, udpIn + 4, (packetSize - 4) / 4, 4);
     }
     strip.show();
     return;
@@ -595,14 +1136,27 @@ void handleNotifications()
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
 {
   uint16_t pix = i + arlsOffset;
-  if (pix < strip.getLengthTotal()) {
+  if (pix < (strip.hasRealtimeSegments() ? strip.getRealtimeInputLength() : strip.getLengthTotal())) {
     if (!arlsDisableGammaCorrection && gammaCorrectCol) {
       r = gamma8(r);
       g = gamma8(g);
       b = gamma8(b);
       w = gamma8(w);
     }
-    if (useMainSegmentOnly) {
+    #ifdef WLED_REALTIME_TASK
+    realtimeIngestLock(); // also called from the main loop (UDP, TPM2.NET, serial)
+    uint32_t *store = realtimeStoreBuffer();
+    if (store || !realtimeInMainLoop()) { // receiving tasks drop pixels until the store exists
+      if (store && pix < rtBufferLen) store[pix] = RGBW32(r, g, b, w);
+      realtimeIngestUnlock();
+      return;
+    }
+    realtimeIngestUnlock();
+    #endif
+    if (strip.hasRealtimeSegments()) {
+      uint32_t c = RGBW32(r, g, b, w);
+      strip.setRealtimeInput(pix, &c, 1);
+    } else if (useMainSegmentOnly) {
       Segment &seg = strip.getMainSegment();
       if (pix<seg.length()) seg.setPixelColor(pix, r, g, b, w);
     } else {
@@ -611,6 +1165,72 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   }
 }
 
+// converts count pixels of 3 (RGB) or 4 (RGBW) channels, applying gamma from the gamma table if requested
+static void realtimeToColors(uint32_t *dst, const uint8_t *data, uint16_t count, uint8_t channels, bool gamma)
+{
+  if (gamma) {
+    if (channels > 3) for (uint16_t j = 0; j < count; j++, data += 4) dst[j] = RGBW32(gamma8(data[0]), gamma8(data[1]), gamma8(data[2]), gamma8(data[3]));
+    else              for (uint16_t j = 0; j < count; j++, data += 3) dst[j] = RGBW32(gamma8(data[0]), gamma8(data[1]), gamma8(data[2]), 0);
+  } else {
+    if (channels > 3) for (uint16_t j = 0; j < count; j++, data += 4) dst[j] = RGBW32(data[0], data[1], data[2], data[3]);
+    else              for (uint16_t j = 0; j < count; j++, data += 3) dst[j] = RGBW32(data[0], data[1], data[2], 0);
+  }
+}
+
+// same as setRealtimePixel() for count consecutive pixels of 3 (RGB) or 4 (RGBW) channels each
+// range checks are done once; without ledmap the pixels are converted straight into the frame buffer,
+// otherwise they are handed to the strip in spans
+void setRealtimePixels(uint16_t i, const uint8_t* data, uint16_t count, uint8_t channels)
+{
+  int pix = i + arlsOffset;
+  bool toSegments = strip.hasRealtimeSegments(); // input for the "Realtime" effect
+  uint16_t totalLen = toSegments ? strip.getRealtimeInputLength() : strip.getLengthTotal();
+  if (useMainSegmentOnly && !toSegments) totalLen = MIN(totalLen, strip.getMainSegment().length());
+  if (pix < 0) { // negative offset, skip leading pixels
+    if (count <= -pix) return;
+    data  -= pix * channels;
+    count += pix;
+    pix    = 0;
+  }
+  if (pix >= totalLen) return;
+  if (count > totalLen - pix) count = totalLen - pix;
+
+  bool gamma = !arlsDisableGammaCorrection && gammaCorrectCol;
+  #ifdef WLED_REALTIME_TASK
+  realtimeIngestLock();
+  uint32_t *store = realtimeStoreBuffer();
+  if (store || !realtimeInMainLoop()) { // receiving tasks drop pixels until the store exists
+    if (store && pix < rtBufferLen) realtimeToColors(store + pix, data, MIN(count, rtBufferLen - pix), channels, gamma);
+    realtimeIngestUnlock();
+    return;
+  }
+  realtimeIngestUnlock();
+  #endif
+  uint32_t *buffer = (useMainSegmentOnly || toSegments) ? nullptr : strip.getPixelSpan(pix, count);
+  if (buffer) {
+    realtimeToColors(buffer, data, count, channels, gamma);
+    strip.commitPixelSpan(pix, count);
+    return;
+  }
+  if (useMainSegmentOnly && !toSegments) strip.getMainSegment().updateRenderContext(); // once per call, not per pixel
+  uint32_t span[32];
+  while (count) {
+    uint16_t n = MIN(count, sizeof(span)/sizeof(uint32_t));
+    realtimeToColors(span, data, n, channels, gamma);
+    data += n * channels;
+    if (toSegments) {
+      strip.setRealtimeInput(pix, span, n);
+    } else if (useMainSegmentOnly) {
+      Segment &seg = strip.getMainSegment();
+      for (uint16_t j = 0; j < n; j++) seg.setPixelColor(pix + j, span[j]);
+    } else {
+      strip.setPixels(pix, span, n);
+    }
+    pix   += n;
+    count -= n;
+  }
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -693,102 +1313,153 @@ void sendSysInfoUDP()
  * Art-Net, DDP, E131 output - work in progress
 \*********************************************************************************************/
 
-#define DDP_HEADER_LEN 10
-#define DDP_SYNCPACKET_LEN 10
-
-#define DDP_FLAGS1_VER 0xc0  // version mask
-#define DDP_FLAGS1_VER1 0x40 // version=1
-#define DDP_FLAGS1_PUSH 0x01
-#define DDP_FLAGS1_QUERY 0x02
-#define DDP_FLAGS1_REPLY 0x04
-#define DDP_FLAGS1_STORAGE 0x08
-#define DDP_FLAGS1_TIME 0x10
-
-#define DDP_ID_DISPLAY 1
-#define DDP_ID_CONFIG 250
-#define DDP_ID_STATUS 251
+// DDP header and flags are defined in ESPAsyncE131.h
 
 // 1440 channels per packet
 #define DDP_CHANNELS_PER_PACKET 1440 // 480 leds
 
+#define ART_NET_HEADER_SIZE 18 // ID, OpCode, version, sequence, physical, universe, length
+#define ARTNET_SEQ 12
+
+#ifndef E131_OUTPUT_PRIORITY
+  #define E131_OUTPUT_PRIORITY 100 // sACN priority of our output (0-200, receivers use the highest priority source)
+#endif
+#define E131_START_UNIVERSE 1      // default first universe of each E1.31 output (universe 0 is reserved)
+
+static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
+static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+static WiFiUDP      ddpUdp;             // kept open between frames
+
+// copies channel data into a packet, applying brightness
+static void scaleChannels(byte *dst, const byte *src, size_t len, uint8_t bri) {
+  if (bri == 255) { memcpy(dst, src, len); return; }
+  for (size_t i = 0; i < len; i++) dst[i] = scale8(src[i], bri);
+}
+
+// sends the first len bytes of the packet
+static bool sendPacket(IPAddress dest, uint16_t port, const byte *packet, size_t len) {
+  if (!ddpUdp.beginPacket(dest, port)) {
+    DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
+    return false;
+  }
+  ddpUdp.write(packet, len);
+  if (!ddpUdp.endPacket()) {
+    DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
+    return false;
+  }
+  if (netOutputPacing) delayMicroseconds(netOutputPacing); // give slow receivers time to process the packet
+  return true;
+}
+
 //
-// Send real time UDP updates to the specified client
+// Allocates the packet buffer a network bus passes to realtimeBroadcast().
+// The buffer holds one packet and is kept for the lifetime of the bus, so the parts
+// of the header that never change are filled in here once.
 //
 // type   - protocol type (0=DDP, 1=E1.31, 2=ArtNet)
-// client - the IP address to send to
-// length - the number of pixels
-// buffer - a buffer of at least length*4 bytes long
-// isRGBW - true if the buffer contains 4 components per pixel
+// isRGBW - true if the bus sends 4 components per pixel
+//
+byte *realtimeBroadcastPacket(uint8_t type, bool isRGBW) {
+  byte *packet = nullptr;
+  switch (type) {
+    case 0: // DDP
+      packet = (byte*) calloc(DDP_HEADER_LEN + DDP_CHANNELS_PER_PACKET, 1);
+      if (!packet) break;
+      packet[2] = isRGBW ? DDP_TYPE_RGBW32 : DDP_TYPE_RGB24;
+      packet[3] = DDP_ID_DISPLAY;
+      break;
+    case 1: // E1.31 root, framing and DMP layer
+      packet = (byte*) calloc(E131_DMP_DATA + 1 + 512, 1); // header + start code + max. channels
+      if (!packet) break;
+      packet[1] = 0x10;                                 // preamble size
+      memcpy_P(packet + E131_ROOT_ID, PSTR("ASC-E1.17"), 9); // ACN packet identifier (12 bytes, zero padded)
+      packet[E131_ROOT_VECTOR+3] = 0x04;                // VECTOR_ROOT_E131_DATA
+      // CID must be unique per source and stable across reboots, so derive it from the MAC address
+      memcpy_P(packet + E131_ROOT_CID, PSTR("WLED"), 4);
+      for (size_t i = 0; i < 6 && escapedMac.length() >= 12; i++) {
+        packet[E131_ROOT_CID + 10 + i] = strtoul(escapedMac.substring(2*i, 2*i+2).c_str(), nullptr, 16);
+      }
+      packet[E131_FRAME_VECTOR+3] = 0x02;               // VECTOR_E131_DATA_PACKET
+      packet[E131_FRAME_PRIORITY] = E131_OUTPUT_PRIORITY;
+      packet[E131_DMP_VECTOR]     = 0x02;               // VECTOR_DMP_SET_PROPERTY
+      packet[E131_DMP_TYPE]       = 0xA1;               // address & data type
+      packet[E131_DMP_ADDR_INC+1] = 0x01;               // address increment
+      break;
+    case 2: // ArtNet
+      packet = (byte*) calloc(ART_NET_HEADER_SIZE + 512, 1);
+      if (!packet) break;
+      memcpy_P(packet, ART_NET_HEADER, sizeof(ART_NET_HEADER)); // Hard coded ID, OpCode, and protocol version.
+      break;
+  }
+  return packet;
+}
 
-static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
-static const size_t ART_NET_HEADER_SIZE = 12;
-static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+// sends the packet to each of the clients
+static bool sendPacket(const IPAddress *clients, uint8_t numClients, uint16_t port, const byte *packet, size_t len) {
+  bool ok = true;
+  for (uint8_t i = 0; i < numClients; i++) ok &= sendPacket(clients[i], port, packet, len);
+  return ok;
+}
 
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW)  {
-  if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
+//
+// Send real time UDP updates to the specified clients
+//
+// type       - protocol type (0=DDP, 1=E1.31, 2=ArtNet)
+// clients    - the IP addresses to send to (every packet goes to each of them)
+// numClients - the number of IP addresses
+// universe   - first E1.31 universe or Art-Net 15 bit port address (net<<8 | subnet<<4 | universe), 0 = protocol default,
+//              DDP: first pixel on the receiver
+// length     - the number of pixels
+// buffer     - a buffer of at least length*4 bytes long
+// bri        - brightness applied to the channel values
+// isRGBW     - true if the buffer contains 4 components per pixel
+// packet     - buffer from realtimeBroadcastPacket() for the same type and isRGBW
+//
+uint8_t realtimeBroadcast(uint8_t type, const IPAddress *clients, uint8_t numClients, uint16_t universe, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW, byte *packet)  {
+  if (!(apActive || interfacesInited) || !numClients || !clients[0][0] || !length || !packet) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
 
-  WiFiUDP ddpUdp;
+  const size_t channelCount = length * (isRGBW? 4:3); // 1 channel for every R,G,B,(W?) value
+  size_t bufferOffset = 0;
 
   switch (type) {
     case 0: // DDP
     {
       // calculate the number of UDP packets we need to send
-      size_t channelCount = length * (isRGBW? 4:3); // 1 channel for every R,G,B value
       size_t packetCount = ((channelCount-1) / DDP_CHANNELS_PER_PACKET) +1;
-
-      // there are 3 channels per RGB pixel
-      uint32_t channel = 0; // TODO: allow specifying the start channel
-      // the current position in the buffer
-      size_t bufferOffset = 0;
+      uint32_t channel = universe * (isRGBW ? 4 : 3); // data offset of the first pixel
 
       for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
         if (sequenceNumber > 15) sequenceNumber = 0;
 
-        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-          DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
-          return 1; // problem
-        }
-
         // the amount of data is AFTER the header in the current packet
         size_t packetSize = DDP_CHANNELS_PER_PACKET;
 
-        uint8_t flags = DDP_FLAGS1_VER1;
+        uint8_t flags = DDP_VERSION_1;
         if (currentPacket == (packetCount - 1U)) {
           // last packet, set the push flag
           // TODO: determine if we want to send an empty push packet to each destination after sending the pixel data
-          flags = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
+          flags = DDP_VERSION_1 | DDP_PUSH_FLAG;
           if (channelCount % DDP_CHANNELS_PER_PACKET) {
             packetSize = channelCount % DDP_CHANNELS_PER_PACKET;
           }
         }
 
-        // write the header
-        /*0*/ddpUdp.write(flags);
-        /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-        /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-        /*3*/ddpUdp.write(DDP_ID_DISPLAY);
+        // type and destination ID are already in the header
+        /*0*/packet[0] = flags;
+        /*1*/packet[1] = sequenceNumber++ & 0x0F; // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
         // data offset in bytes, 32-bit number, MSB first
-        /*4*/ddpUdp.write(0xFF & (channel >> 24));
-        /*5*/ddpUdp.write(0xFF & (channel >> 16));
-        /*6*/ddpUdp.write(0xFF & (channel >>  8));
-        /*7*/ddpUdp.write(0xFF & (channel      ));
+        /*4*/packet[4] = 0xFF & (channel >> 24);
+        /*5*/packet[5] = 0xFF & (channel >> 16);
+        /*6*/packet[6] = 0xFF & (channel >>  8);
+        /*7*/packet[7] = 0xFF & (channel      );
         // data length in bytes, 16-bit number, MSB first
-        /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-        /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-        // write the colors, the write write(const uint8_t *buffer, size_t size)
-        // function is just a loop internally too
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
+        /*8*/packet[8] = 0xFF & (packetSize >> 8);
+        /*9*/packet[9] = 0xFF & (packetSize     );
 
-        if (!ddpUdp.endPacket()) {
-          DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
-          return 1; // problem
-        }
+        scaleChannels(packet + DDP_HEADER_LEN, buffer + bufferOffset, packetSize, bri);
+        bufferOffset += packetSize;
+
+        if (!sendPacket(clients, numClients, DDP_DEFAULT_PORT, packet, DDP_HEADER_LEN + packetSize)) return 1; // problem  (port defined in ESPAsyncE131.h)
 
         channel += packetSize;
       }
@@ -796,29 +1467,56 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8
 
     case 1: //E1.31
     {
+      // one universe per packet, never split a pixel across universes
+      const size_t E131_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
+      const size_t packetCount = ((channelCount-1)/E131_CHANNELS_PER_PACKET)+1;
+      if (!universe) universe = E131_START_UNIVERSE;
+
+      strlcpy((char*)packet + E131_FRAME_SOURCE, serverDescription, 64); // may have been renamed
+      packet[E131_FRAME_SEQ]++; // one sequence number per frame
+
+      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+        size_t packetSize = E131_CHANNELS_PER_PACKET;
+        if (currentPacket == (packetCount - 1U) && (channelCount % E131_CHANNELS_PER_PACKET)) {
+          packetSize = channelCount % E131_CHANNELS_PER_PACKET; // last packet
+        }
+        const uint16_t packetUniverse = universe + currentPacket;
+        const size_t   totalLen = E131_DMP_DATA + 1 + packetSize;
+
+        // PDU lengths (low 12 bits) with flags 0x7
+        packet[E131_ROOT_FLENGTH]    = 0x70 | ((totalLen - E131_ROOT_FLENGTH) >> 8);
+        packet[E131_ROOT_FLENGTH+1]  = 0xFF & (totalLen - E131_ROOT_FLENGTH);
+        packet[E131_FRAME_FLENGTH]   = 0x70 | ((totalLen - E131_FRAME_FLENGTH) >> 8);
+        packet[E131_FRAME_FLENGTH+1] = 0xFF & (totalLen - E131_FRAME_FLENGTH);
+        packet[E131_DMP_FLENGTH]     = 0x70 | ((totalLen - E131_DMP_FLENGTH) >> 8);
+        packet[E131_DMP_FLENGTH+1]   = 0xFF & (totalLen - E131_DMP_FLENGTH);
+        packet[E131_FRAME_UNIVERSE]   = packetUniverse >> 8;
+        packet[E131_FRAME_UNIVERSE+1] = packetUniverse & 0xFF;
+        packet[E131_DMP_COUNT]        = (packetSize + 1) >> 8; // channels + start code
+        packet[E131_DMP_COUNT+1]      = (packetSize + 1) & 0xFF;
+        packet[E131_DMP_DATA]         = 0x00; // DMX start code
+
+        scaleChannels(packet + E131_DMP_DATA + 1, buffer + bufferOffset, packetSize, bri);
+        bufferOffset += packetSize;
+
+        for (uint8_t i = 0; i < numClients; i++) {
+          // a multicast address (239.255.x.x) means every universe is sent to its own multicast group
+          const bool multicast = clients[i][0] == 239 && clients[i][1] == 255;
+          IPAddress dest = multicast ? IPAddress(239, 255, packetUniverse >> 8, packetUniverse & 0xFF) : clients[i];
+          if (!sendPacket(dest, E131_DEFAULT_PORT, packet, totalLen)) return 1; // problem
+        }
+      }
     } break;
 
     case 2: //ArtNet
     {
       // calculate the number of UDP packets we need to send
-      const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
       const size_t ARTNET_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
       const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
 
-      uint32_t channel = 0; 
-      size_t bufferOffset = 0;
-
-      sequenceNumber++;
+      if (++packet[ARTNET_SEQ] == 0) packet[ARTNET_SEQ] = 1; // sequence number. 1..255 (0 disables sequencing)
 
       for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
-        if (sequenceNumber > 255) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
-        }
-
         size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
 
         if (currentPacket == (packetCount - 1U)) {
@@ -828,30 +1526,37 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8
           }
         }
 
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
+        // 1 full packet == 1 full universe, consecutive port addresses carry over into subnet and net
+        const uint16_t portAddress = (universe + currentPacket) & 0x7FFF;
 
-        if (!ddpUdp.endPacket()) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
-          return 1; // borked
-        }
-        channel += packetSize;
+        packet[13] = 0x00; // physical - more an FYI, not really used for anything. 0..3
+        packet[14] = portAddress & 0xFF; // SubUni: subnet (high nibble) and universe (low nibble)
+        packet[15] = portAddress >> 8;   // Net (7 bits)
+        packet[16] = 0xFF & (packetSize >> 8); // 16-bit length of channel data, MSB
+        packet[17] = 0xFF & (packetSize     ); // 16-bit length of channel data, LSB
+
+        scaleChannels(packet + ART_NET_HEADER_SIZE, buffer + bufferOffset, packetSize, bri);
+        bufferOffset += packetSize;
+
+        if (!sendPacket(clients, numClients, ARTNET_DEFAULT_PORT, packet, ART_NET_HEADER_SIZE + packetSize)) return 1; // borked
       }
     } break;
   }
   return 0;
 }
+
+//
+// Send an ArtSync packet, so Art-Net nodes output the ArtDmx data received since the last one at the same time.
+// Nodes that never receive ArtSync output each ArtDmx packet right away, so this is harmless for them.
+// Sent by a network bus to its own destinations once all of its ArtDmx packets of the frame have been sent.
+//
+void realtimeBroadcastSync(const IPAddress *clients, uint8_t numClients) {
+  if (!(apActive || interfacesInited) || !numClients || !clients[0][0]) return;
+  byte packet[sizeof(ART_NET_HEADER)+2];
+  memcpy_P(packet, ART_NET_HEADER, sizeof(ART_NET_HEADER)); // ID, OpCode and protocol version
+  packet[9]  = 0x52; // OpSync (0x5200, LSB first)
+  packet[12] = 0x00; // Aux1
+  packet[13] = 0x00; // Aux2
+  // sent to the nodes that received the frame only, other controllers' nodes must not latch their frames
+  sendPacket(clients, numClients, ARTNET_DEFAULT_PORT, packet, sizeof(packet));
+}
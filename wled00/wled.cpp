@@ -60,6 +60,7 @@ void WLED::loop()
   handleSerial();
   handleImprovWifiScan();
   handleNotifications();
+  busses.loop(); // network busses sending a frame in parts
   handleTransitions();
 #ifdef WLED_ENABLE_DMX
   handleDMX();
@@ -93,7 +94,7 @@ void WLED::loop()
   #ifdef WLED_DEBUG
   stripMillis = millis();
   #endif
-  if (!realtimeMode || realtimeOverride || (realtimeMode && useMainSegmentOnly))  // block stuff if WARLS/Adalight is enabled
+  if (!realtimeMode || realtimeOverride || (realtimeMode && useMainSegmentOnly) || strip.hasRealtimeSegments())  // block stuff if WARLS/Adalight is enabled
   {
     if (apActive) dnsServer.processNextRequest();
     #ifndef WLED_DISABLE_OTA
@@ -168,7 +169,7 @@ void WLED::loop()
       mem += BusManager::memUsage(*busConfigs[i]);
       if (useGlobalLedBuffer && busConfigs[i]->start + busConfigs[i]->count > maxlen) {
           maxlen = busConfigs[i]->start + busConfigs[i]->count;
-          globalBufMem = maxlen * 4;
+          globalBufMem = WS2812FX::frameBufferMem(maxlen);
       }
       if (mem + globalBufMem <= MAX_LED_MEMORY) {
         busses.add(*busConfigs[i]);
@@ -499,6 +500,10 @@ pinManager.allocateMultiplePins(pins, sizeof(pins)/sizeof(managed_pin_type), Pin
   initServer();
   DEBUG_PRINT(F("heap ")); DEBUG_PRINTLN(ESP.getFreeHeap());
 
+  #ifdef WLED_REALTIME_TASK
+  startRealtimeTask();
+  #endif
+
   enableWatchdog();
 
   #if defined(ARDUINO_ARCH_ESP32) && defined(WLED_DISABLE_BROWNOUT_DET)
@@ -557,9 +562,11 @@ void WLED::initAP(bool resetAP)
     if (udpPort > 0 && udpPort != ntpLocalPort) {
       udpConnected = notifierUdp.begin(udpPort);
     }
+    #ifndef WLED_REALTIME_TASK // the realtime task opens the Hyperion port itself
     if (udpRgbPort > 0 && udpRgbPort != ntpLocalPort && udpRgbPort != udpPort) {
       udpRgbConnected = rgbUdp.begin(udpRgbPort);
     }
+    #endif
     if (udpPort2 > 0 && udpPort2 != ntpLocalPort && udpPort2 != udpPort && udpPort2 != udpRgbPort) {
       udp2Connected = notifier2Udp.begin(udpPort2);
     }
@@ -774,8 +781,10 @@ void WLED::initInterfaces()
 
   if (udpPort > 0 && udpPort != ntpLocalPort) {
     udpConnected = notifierUdp.begin(udpPort);
+    #ifndef WLED_REALTIME_TASK // the realtime task opens the Hyperion port itself
     if (udpConnected && udpRgbPort != udpPort)
       udpRgbConnected = rgbUdp.begin(udpRgbPort);
+    #endif
     if (udpConnected && udpPort2 != udpPort && udpPort2 != udpRgbPort)
       udp2Connected = notifier2Udp.begin(udpPort2);
   }
@@ -234,6 +234,22 @@ void initServer()
     request->send(200, "text/plain", (String)ESP.getFreeHeap());
   });
 
+  // realtime input statistics in binary form, little endian:
+  // 8 byte header "RS", version, protocols, jitter bins, universes, 2x 0
+  // then per protocol (RT_STATS_*) the realtime_stats_t counters packets..jitter[] as uint32
+  // and per universe [packets, gaps] as uint32; "?reset" clears the statistics after reading
+  server.on(SET_F("/rtstats"), HTTP_GET, [](AsyncWebServerRequest *request){
+    const uint8_t header[8] = {'R', 'S', 1, RT_STATS_PROTOCOLS, RT_STATS_JITTER_BINS, E131_MAX_UNIVERSE_COUNT, 0, 0};
+    AsyncResponseStream *response = request->beginResponseStream("application/octet-stream");
+    response->write(header, sizeof(header));
+    for (uint8_t i = 0; i < RT_STATS_PROTOCOLS; i++) {
+      response->write((const uint8_t*)&realtimeStats[i], offsetof(realtime_stats_t, lastPacket));
+    }
+    response->write((const uint8_t*)realtimeUniverseStats, sizeof(realtimeUniverseStats));
+    request->send(response);
+    if (request->hasArg(F("reset"))) resetRealtimeStats();
+  });
+
 #ifdef WLED_ENABLE_USERMOD_PAGE
   server.on("/u", HTTP_GET, [](AsyncWebServerRequest *request){
     if (handleIfNoneMatchCacheHeader(request)) return;